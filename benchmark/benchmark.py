@@ -0,0 +1,317 @@
+#!/usr/bin/env python
+
+"""
+Runs the benchmark suite and compares the results with a baseline.
+
+  benchmark.py run [--output results.json] [--bin-dir DIR] [...]
+  benchmark.py compare baseline.json results.json [thresholds]
+
+For each case the wall-clock time (median of the repetitions), the peak
+resident set size of the tool, and, where the tool reports them, the
+number of SSA steps and the numbers of SAT variables and clauses are
+recorded.
+"""
+
+from __future__ import print_function
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shlex
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+import generate
+
+
+def same_dir(filename):
+    d = os.path.dirname(os.path.abspath(__file__))
+    return os.path.join(d, filename)
+
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+STEPS_RE = re.compile(r'^size of program expression: (\d+) steps$',
+                      re.MULTILINE)
+FORMULA_RE = re.compile(r'^(\d+) variables, (\d+) clauses$', re.MULTILINE)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+    subparsers = parser.add_subparsers(dest='command')
+
+    run = subparsers.add_parser('run', help='run the benchmark suite')
+    run.add_argument('-s', '--suite', type=str,
+                     default=same_dir('suite.json'),
+                     help='suite to run (default: suite.json)')
+    run.add_argument('-o', '--output', type=str,
+                     default=same_dir('results.json'),
+                     help='file to write the results to ' +
+                          '(default: results.json)')
+    run.add_argument('-b', '--bin-dir', type=str,
+                     help='directory containing all the tools, as in ' +
+                          'CMake builds (default: src/<tool>/<tool>)')
+    run.add_argument('-r', '--repeat', type=int, default=3,
+                     help='number of runs per case (default: 3)')
+    run.add_argument('-t', '--timeout', type=int, default=600,
+                     help='timeout per run in seconds (default: 600)')
+    run.add_argument('-f', '--filter', type=str,
+                     help='only run the cases whose name matches this ' +
+                          'regular expression')
+
+    compare = subparsers.add_parser(
+        'compare', help='compare results with a baseline')
+    compare.add_argument('baseline', type=str)
+    compare.add_argument('results', type=str)
+    compare.add_argument('--time-threshold', type=float, default=0.10,
+                         help='relative increase of the time that is ' +
+                              'a regression (default: 0.10)')
+    compare.add_argument('--min-time', type=float, default=0.10,
+                         help='increase of the time in seconds below ' +
+                              'which it is noise (default: 0.10)')
+    compare.add_argument('--memory-threshold', type=float, default=0.10,
+                         help='relative increase of the peak memory ' +
+                              'that is a regression (default: 0.10)')
+    compare.add_argument('--size-threshold', type=float, default=0.0,
+                         help='relative increase of the number of steps, ' +
+                              'variables or clauses that is a regression ' +
+                              '(default: 0.0)')
+
+    args = parser.parse_args()
+    if args.command is None:
+        parser.error('expected a command: run or compare')
+
+    return args
+
+
+def tool_path(tool, bin_dir):
+    if bin_dir:
+        return os.path.join(bin_dir, tool)
+    return os.path.join(ROOT, 'src', tool, tool)
+
+
+def load_test_desc(test_dir):
+    """
+    Returns the input file and the options of a test.desc, in the format
+    of regression/test.pl. Only CORE tests are accepted, as the others
+    are not expected to pass.
+    """
+    with open(os.path.join(test_dir, 'test.desc')) as f:
+        lines = f.read().splitlines()
+    if lines[0].strip() != 'CORE':
+        raise ValueError('{}: level is {}, not CORE'.format(
+            test_dir, lines[0].strip()))
+    return lines[1].strip(), shlex.split(lines[2])
+
+
+def prepare(case, work_dir):
+    """
+    Returns the directory to run the case in and its command line,
+    without the tool.
+    """
+    if 'generator' in case:
+        source, args = generate.generators[case['generator']](case['size'])
+        case_dir = os.path.join(work_dir, case['name'].replace('/', '_'))
+        os.makedirs(case_dir)
+        with open(os.path.join(case_dir, 'main.c'), 'w') as f:
+            f.write(source)
+        return case_dir, ['main.c'] + case.get('args', args)
+
+    test_dir = os.path.join(ROOT, case['test'])
+    input_file, args = load_test_desc(test_dir)
+    return test_dir, [input_file] + case.get('args', args)
+
+
+def run_once(cmdline, cwd, timeout):
+    """
+    Returns the exit code, the wall-clock time, the peak resident set size
+    in bytes and the output of a single run.
+    """
+    with tempfile.TemporaryFile() as output:
+        start = time.time()
+        process = subprocess.Popen(cmdline, cwd=cwd, stdout=output,
+                                   stderr=subprocess.STDOUT)
+
+        def kill():
+            try:
+                os.kill(process.pid, signal.SIGKILL)
+            except OSError:
+                pass
+
+        timer = threading.Timer(timeout, kill)
+        timer.start()
+        # wait4 rather than wait, for the resource usage of this process
+        # only
+        _, status, rusage = os.wait4(process.pid, 0)
+        elapsed = time.time() - start
+        timer.cancel()
+        process.returncode = status
+
+        if os.WIFSIGNALED(status):
+            exit_code = -os.WTERMSIG(status)
+        else:
+            exit_code = os.WEXITSTATUS(status)
+
+        peak_memory = rusage.ru_maxrss
+        if platform.system() != 'Darwin':
+            peak_memory *= 1024
+
+        output.seek(0)
+        return exit_code, elapsed, peak_memory, \
+            output.read().decode('utf-8', 'replace')
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    if len(values) % 2 == 1:
+        return values[middle]
+    return (values[middle - 1] + values[middle]) / 2.0
+
+
+def run_case(case, args, work_dir):
+    cwd, cmdline = prepare(case, work_dir)
+    cmdline = [tool_path(case['tool'], args.bin_dir)] + cmdline
+
+    result = {
+        'tool': case['tool'],
+        'commandLine': ' '.join(cmdline[1:]),
+        'times': [],
+        'peakMemory': 0,
+    }
+
+    for _ in range(args.repeat):
+        exit_code, elapsed, peak_memory, output = \
+            run_once(cmdline, cwd, args.timeout)
+        result['exitCode'] = exit_code
+        result['times'].append(elapsed)
+        result['peakMemory'] = max(result['peakMemory'], peak_memory)
+
+    result['time'] = median(result['times'])
+    result['timeout'] = exit_code == -signal.SIGKILL
+
+    # the counts are deterministic, the output of the last run will do;
+    # with incremental solving, the last figures are the totals
+    steps = STEPS_RE.findall(output)
+    if steps:
+        result['steps'] = int(steps[-1])
+    formula = FORMULA_RE.findall(output)
+    if formula:
+        result['variables'] = int(formula[-1][0])
+        result['clauses'] = int(formula[-1][1])
+
+    return result
+
+
+def git_revision():
+    try:
+        return subprocess.check_output(
+            ['git', 'rev-parse', 'HEAD'], cwd=ROOT,
+            stderr=subprocess.STDOUT).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ''
+
+
+def run(args):
+    with open(args.suite) as f:
+        suite = json.load(f)
+
+    results = {
+        'date': datetime.datetime.utcnow().isoformat(),
+        'host': platform.node(),
+        'revision': git_revision(),
+        'repeat': args.repeat,
+        'cases': {},
+    }
+
+    work_dir = tempfile.mkdtemp()
+    try:
+        for case in suite['cases']:
+            if args.filter and not re.search(args.filter, case['name']):
+                continue
+
+            print(case['name'], end=': ')
+            sys.stdout.flush()
+
+            result = run_case(case, args, work_dir)
+            results['cases'][case['name']] = result
+
+            print('{:.3f}s, {:.1f} MB, exit code {}{}'.format(
+                result['time'], result['peakMemory'] / 1048576.0,
+                result['exitCode'],
+                ' (timeout)' if result['timeout'] else ''))
+    finally:
+        shutil.rmtree(work_dir)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+        f.write('\n')
+
+    return 0
+
+
+def compare(args):
+    with open(args.baseline) as f:
+        baseline = json.load(f)['cases']
+    with open(args.results) as f:
+        results = json.load(f)['cases']
+
+    regressions = 0
+
+    for name in sorted(results):
+        if name not in baseline:
+            print('{}: not in the baseline'.format(name))
+            continue
+
+        old = baseline[name]
+        new = results[name]
+        messages = []
+
+        if old['exitCode'] != new['exitCode']:
+            messages.append('exit code {} -> {}'.format(
+                old['exitCode'], new['exitCode']))
+
+        if new['time'] - old['time'] > \
+                max(args.min_time, old['time'] * args.time_threshold):
+            messages.append('time {:.3f}s -> {:.3f}s'.format(
+                old['time'], new['time']))
+
+        if new['peakMemory'] > old['peakMemory'] * (1 + args.memory_threshold):
+            messages.append('peak memory {:.1f} MB -> {:.1f} MB'.format(
+                old['peakMemory'] / 1048576.0, new['peakMemory'] / 1048576.0))
+
+        for key in ['steps', 'variables', 'clauses']:
+            if key in old and key in new and \
+                    new[key] > old[key] * (1 + args.size_threshold):
+                messages.append('{} {} -> {}'.format(key, old[key], new[key]))
+
+        if messages:
+            regressions += 1
+            print('{}: {}'.format(name, ', '.join(messages)))
+
+    for name in sorted(baseline):
+        if name not in results:
+            print('{}: not in the results'.format(name))
+
+    print('{} of {} cases regressed'.format(regressions, len(results)))
+
+    return 1 if regressions else 0
+
+
+def main():
+    args = parse_args()
+    if args.command == 'run':
+        return run(args)
+    return compare(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
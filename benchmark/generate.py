@@ -0,0 +1,189 @@
+"""
+Generators of synthetic benchmarks whose size is given by a parameter.
+
+Each generator takes the size n and returns the source code of a C
+program together with the command-line options to check it with.
+"""
+
+from __future__ import print_function
+
+
+def loops(n):
+    """
+    Nested loops with n iterations each, to scale the unwinding.
+    """
+    source = """\
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned sum=0;
+
+  for(unsigned i=0; i<%(n)d; i++)
+    for(unsigned j=0; j<%(n)d; j++)
+      sum+=nondet_unsigned()%%2;
+
+  __CPROVER_assert(sum<=%(n)d*%(n)d, "sum is bounded");
+
+  return 0;
+}
+""" % {'n': n}
+    return source, ['--unwind', str(n + 1)]
+
+
+def arrays(n):
+    """
+    Bubble sort of an array of n nondeterministic elements, to scale the
+    array theory and the number of array updates.
+    """
+    source = """\
+int nondet_int();
+
+int a[%(n)d];
+
+int main()
+{
+  for(int i=0; i<%(n)d; i++)
+    a[i]=nondet_int();
+
+  for(int i=0; i<%(n)d; i++)
+    for(int j=0; j+1<%(n)d-i; j++)
+      if(a[j]>a[j+1])
+      {
+        int t=a[j];
+        a[j]=a[j+1];
+        a[j+1]=t;
+      }
+
+  for(int i=0; i+1<%(n)d; i++)
+    __CPROVER_assert(a[i]<=a[i+1], "array is sorted");
+
+  return 0;
+}
+""" % {'n': n}
+    return source, ['--unwind', str(n + 1), '--bounds-check']
+
+
+def pointers(n):
+    """
+    A linked list of n heap-allocated nodes that is built and traversed,
+    to scale the value sets and pointer dereferencing.
+    """
+    source = """\
+#include <stdlib.h>
+
+struct nodet
+{
+  struct nodet *next;
+  int value;
+};
+
+int nondet_int();
+
+int main()
+{
+  struct nodet *list=NULL;
+
+  for(int i=0; i<%(n)d; i++)
+  {
+    struct nodet *node=malloc(sizeof(struct nodet));
+    __CPROVER_assume(node!=NULL);
+    node->value=nondet_int();
+    __CPROVER_assume(node->value>=0 && node->value<1000);
+    node->next=list;
+    list=node;
+  }
+
+  long sum=0;
+
+  for(struct nodet *p=list; p!=NULL; p=p->next)
+    sum+=p->value;
+
+  __CPROVER_assert(sum<1000l*%(n)d, "sum is bounded");
+
+  return 0;
+}
+""" % {'n': n}
+    return source, ['--unwind', str(n + 1), '--pointer-check']
+
+
+def concurrency(n):
+    """
+    n threads that increment a shared counter in an atomic section, to
+    scale the number of interleavings the memory model has to encode.
+    """
+    source = """\
+#include <pthread.h>
+
+unsigned counter=0;
+
+void *worker(void *arg)
+{
+  __CPROVER_atomic_begin();
+  counter++;
+  __CPROVER_atomic_end();
+  return 0;
+}
+
+int main()
+{
+  pthread_t threads[%(n)d];
+
+  for(int i=0; i<%(n)d; i++)
+    pthread_create(&threads[i], 0, worker, 0);
+
+  for(int i=0; i<%(n)d; i++)
+    pthread_join(threads[i], 0);
+
+  __CPROVER_assert(counter<=%(n)d, "counter is bounded");
+
+  return 0;
+}
+""" % {'n': n}
+    return source, ['--unwind', str(n + 1)]
+
+
+def shared_accesses(n):
+    """
+    n threads that each write and read a shared variable n times without
+    synchronisation, to scale the number of shared accesses and with it
+    the read-from and write-serialisation constraints of the memory
+    model.
+    """
+    source = """\
+#include <pthread.h>
+
+int shared=0;
+
+void *worker(void *arg)
+{
+  for(int i=0; i<%(n)d; i++)
+  {
+    shared=i;
+    int observed=shared;
+    __CPROVER_assert(observed>=0 && observed<%(n)d, "shared is in range");
+  }
+
+  return 0;
+}
+
+int main()
+{
+  pthread_t threads[%(n)d];
+
+  for(int i=0; i<%(n)d; i++)
+    pthread_create(&threads[i], 0, worker, 0);
+
+  return 0;
+}
+""" % {'n': n}
+    return source, ['--unwind', str(n + 1)]
+
+
+generators = {
+    'loops': loops,
+    'arrays': arrays,
+    'pointers': pointers,
+    'concurrency': concurrency,
+    'shared_accesses': shared_accesses,
+}
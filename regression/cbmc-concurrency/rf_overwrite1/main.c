@@ -0,0 +1,29 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x;
+
+void *thread(void *arg)
+{
+  x = 1;
+  x = 2;
+  int s = x;
+  // the thread's own x = 1 has been overwritten
+  assert(s != 1);
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t id;
+  pthread_create(&id, NULL, thread, NULL);
+
+  x = 10;
+  x = 20;
+  int r = x;
+  // the main thread's own x = 10 has been overwritten
+  assert(r != 10);
+  // but the other thread may have written in between
+  assert(r == 20);
+  return 0;
+}
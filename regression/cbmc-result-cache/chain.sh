@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+
+cbmc=$1
+
+options=${*:2:$#-2}
+name=${*:$#}
+name=${name%.c}
+
+cache="${name}.cache"
+rm -f "${cache}"
+
+echo "first run"
+"${cbmc}" "${name}.c" ${options} --result-cache "${cache}"
+
+echo "second run"
+"${cbmc}" "${name}.c" ${options} --result-cache "${cache}"
+
+# a copy of the program with an edited function, if there is one
+if [[ -f "${name}-edited.c" ]]; then
+  echo "edited run"
+  "${cbmc}" "${name}-edited.c" ${options} --result-cache "${cache}"
+fi
@@ -0,0 +1,21 @@
+int g(int x)
+{
+  __CPROVER_assert(x*0==0, "g");
+  return x;
+}
+
+int f(int x)
+{
+  int y=x*2+1;
+  __CPROVER_assert(y%2==0, "f");
+  return y;
+}
+
+int main()
+{
+  int a;
+  // g is called first, such that its property does not depend on f
+  g(a);
+  f(a);
+  return 0;
+}
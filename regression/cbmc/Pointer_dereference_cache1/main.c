@@ -0,0 +1,36 @@
+struct node
+{
+  int value;
+  struct node *next;
+};
+
+int main()
+{
+  struct node n1, n2, n3;
+  n1.value=1;
+  n1.next=&n2;
+  n2.value=2;
+  n2.next=&n3;
+  n3.value=3;
+  n3.next=0;
+
+  struct node *p=&n1;
+  int x=p->value;
+  // the same dereference, value set unchanged
+  int y=p->value;
+  assert(x==y);
+
+  p=p->next;
+  // the pointer now has a different value set
+  assert(p->value==2);
+
+  _Bool c;
+  struct node *q=c ? &n1 : &n3;
+  q->value=42;
+  // q may point to two objects, and writing through it must be seen
+  // by reads through p and its successors
+  assert(c || p->next->value==42);
+  assert(p->next->value==3);
+
+  return 0;
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  unsigned char x, y;
+  unsigned char z=x^y;
+
+  __CPROVER_assert((z^y)==x, "xor is invertible");
+  __CPROVER_assert(z!=0 || x==y, "zero xor implies equality");
+
+  return 0;
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x==3 && y<10);
+
+  unsigned z=x*y+x;
+  __CPROVER_assert(z!=27, "z is not 27");
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int y=0;
+
+  if(x>0)
+  {
+    if(x>10)
+      y=2;
+    else
+      y=1;
+  }
+  else
+  {
+    if(x<-10)
+      y=-2;
+    else
+      y=-1;
+  }
+
+  __CPROVER_assert(y!=0, "y is set on all paths");
+  __CPROVER_assert(x<=10 || y==2, "y is 2 above 10");
+  __CPROVER_assert(y!=-1, "y is not -1");
+
+  return 0;
+}
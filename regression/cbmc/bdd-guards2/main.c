@@ -0,0 +1,25 @@
+int nondet_int();
+
+int main()
+{
+  int a=nondet_int();
+  int b=nondet_int();
+  int c=nondet_int();
+  int y=0;
+
+  if(a>0)
+    goto out;
+  if(b>0)
+    goto out;
+  if(c>0)
+    goto out;
+
+  y=1;
+
+out:
+  // all four paths join here: merged pairwise, the guards form a
+  // disjunction that does not simplify, as BDD it is true
+  __CPROVER_assert(y<=1, "y is 0 or 1");
+
+  return 0;
+}
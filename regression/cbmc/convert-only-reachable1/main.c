@@ -0,0 +1,26 @@
+int unreachable(int x)
+{
+  return x+1;
+}
+
+int via_pointer(int x)
+{
+  return x*2;
+}
+
+int callee(int x)
+{
+  int (*fp)(int)=via_pointer;
+  return fp(x);
+}
+
+void entry(int x)
+{
+  __CPROVER_assume(x>0 && x<100);
+  assert(callee(x)==2*x);
+}
+
+int main()
+{
+  return unreachable(0);
+}
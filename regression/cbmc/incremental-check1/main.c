@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int x=0, y=0;
+  int n=nondet_int();
+
+  while(x<n)
+  {
+    if(x==6)
+      y=1;
+    x++;
+  }
+
+  assert(y==0);
+
+  return 0;
+}
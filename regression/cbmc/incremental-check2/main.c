@@ -0,0 +1,14 @@
+int main()
+{
+  unsigned x=0, sum=0;
+
+  while(x<5)
+  {
+    sum+=x;
+    x++;
+  }
+
+  assert(sum==10);
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+int main()
+{
+  int x;
+  int y=0;
+
+  for(int i=0; i<4; i++)
+    y+=x;
+
+  __CPROVER_assert(y!=4*x, "y is 4*x");
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+unsigned nondet_unsigned();
+
+unsigned square(unsigned x)
+{
+  return x*x;
+}
+
+int main()
+{
+  unsigned sum=0;
+
+  for(int i=0; i<3; i++)
+    sum+=square(nondet_unsigned());
+
+  __CPROVER_assert(sum!=2, "sum is not 2");
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int a[4];
+  int sum=0;
+
+  for(int i=0; i<4; i++)
+  {
+    a[i]=nondet_int();
+    __CPROVER_assume(a[i]>=0 && a[i]<10);
+    sum+=a[i];
+  }
+
+  __CPROVER_assert(sum<36, "sum is bounded");
+
+  return 0;
+}
@@ -0,0 +1,23 @@
+int unrelated;
+
+void update(int *p)
+{
+  *p=*p+1;
+  unrelated=*p*3;
+}
+
+int main()
+{
+  int x=0, y=0;
+
+  for(int i=0; i<4; ++i)
+  {
+    update(&x);
+    y=y*2+unrelated;
+  }
+
+  assert(x==4);
+  assert(x!=4);
+
+  return 0;
+}
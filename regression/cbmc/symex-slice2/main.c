@@ -0,0 +1,23 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int y=nondet_int();
+  unsigned counter=0;
+
+  // only relevant through the assumption
+  __CPROVER_assume(x>0 && x<10);
+
+  // unbounded, but irrelevant to the assertions
+  while(y!=0)
+  {
+    ++counter;
+    y=nondet_int();
+  }
+
+  assert(x>0);
+  assert(x<5);
+
+  return 0;
+}
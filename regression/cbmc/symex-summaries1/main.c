@@ -0,0 +1,31 @@
+int nondet_int();
+
+int table[4]={1, 2, 3, 4};
+
+int weight(int x)
+{
+  __CPROVER_assert(x!=5, "x is not 5");
+
+  int r=x*3;
+  if(x>2)
+    r=r+table[x&3];
+  return r;
+}
+
+int main()
+{
+  int a=nondet_int();
+  int s1=weight(a);
+  int s2=weight(a);
+  __CPROVER_assert(s1==s2, "same inputs");
+
+  int b=a+1;
+  int s3=weight(b);
+  if(a>0)
+  {
+    int s4=weight(b);
+    __CPROVER_assert(s3==s4, "same inputs on a branch");
+  }
+
+  return 0;
+}
@@ -0,0 +1,13 @@
+int f(int a)
+{
+  int y;
+  return a+y;
+}
+
+int main()
+{
+  // y is nondeterministic on each call
+  __CPROVER_assert(f(1)==f(1), "uninitialized local");
+
+  return 0;
+}
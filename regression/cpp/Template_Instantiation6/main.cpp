@@ -0,0 +1,27 @@
+template <typename T>
+class box
+{
+public:
+  T value;
+  T get() { return value; }
+};
+
+template <typename T>
+T twice(T x)
+{
+  return x+x;
+}
+
+box<int> b1;
+box<int> b2;
+box<char> b3;
+
+int main()
+{
+  box<int> b4;
+  b4.value=twice(1);
+  b1.value=twice(2);
+  b3.value=twice((char)3);
+  __CPROVER_assert(b4.get()+b1.get()==6, "repeated instances agree");
+  __CPROVER_assert(sizeof(b2)==sizeof(b4), "same instance type");
+}
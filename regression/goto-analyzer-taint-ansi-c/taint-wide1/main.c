@@ -0,0 +1,12 @@
+void source(void *p) { }
+void sanitize(void *p) { }
+void sink(void *p) { }
+
+void my_function()
+{
+  void *o;
+
+  source(o); // T0, ..., T69 source
+  sanitize(o); // T0, T64 sanitizer
+  sink(o); // T0, T5, T64, T69 sink
+}
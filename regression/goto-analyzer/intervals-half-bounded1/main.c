@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main(void)
+{
+  int y=nondet_int();
+  int x=-1;
+
+  if(y>=0)
+  {
+    x=y;
+    assert(x>=0);
+    assert(x<100);
+  }
+
+  assert(x>=-1);
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main(void)
+{
+  int x=nondet_int();
+  int y=nondet_int();
+
+  if(x>=0)
+  {
+    // may wrap around to INT_MIN
+    x=x+1;
+    assert(x>=1);
+  }
+
+  if(y>=0 && y<100)
+  {
+    y=y+1;
+    assert(y>=1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,22 @@
+#include <assert.h>
+
+int main(void)
+{
+  int x=0;
+  int y=0;
+
+  while(x<10)
+  {
+    x++;
+    if(x<5)
+      y=3;
+    else
+      y=7;
+  }
+
+  assert(x>=10);
+  assert(y<=7);
+  assert(y<5);
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+void fence() { asm("mfence"); }
+
+int __unbuffered_cnt=0;
+int __unbuffered_p0_r1=0;
+int __unbuffered_p1_r1=0;
+int __unbuffered_p2_r1=0;
+int x=0;
+int y=0;
+int z=0;
+
+void *P0(void *arg)
+{
+  x=1;
+  __unbuffered_p0_r1=y;
+  fence();
+  __unbuffered_cnt++;
+}
+
+void *P1(void *arg)
+{
+  y=1;
+  __unbuffered_p1_r1=z;
+  fence();
+  __unbuffered_cnt++;
+}
+
+void *P2(void *arg)
+{
+  z=1;
+  __unbuffered_p2_r1=x;
+  fence();
+  __unbuffered_cnt++;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_0: P0(0);
+  __CPROVER_ASYNC_1: P1(0);
+  __CPROVER_ASYNC_2: P2(0);
+  __CPROVER_assume(__unbuffered_cnt==3);
+  fence();
+  // store buffering over three threads: the only critical cycle has six
+  // events, as no two threads access the same pair of variables
+  __CPROVER_assert(
+    !(__unbuffered_p0_r1==0 && __unbuffered_p1_r1==0 &&
+      __unbuffered_p2_r1==0),
+    "store buffering is not observable");
+  return 0;
+}
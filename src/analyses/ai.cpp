@@ -15,11 +15,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <memory>
 #include <sstream>
 
+#include <util/arith_tools.h>
 #include <util/simplify_expr.h>
 #include <util/std_expr.h>
 #include <util/std_code.h>
 
 #include "is_threaded.h"
+#include "natural_loops.h"
 
 jsont ai_domain_baset::output_json(
   const ai_baset &ai,
@@ -268,10 +270,92 @@ void ai_baset::initialize(const goto_functionst::goto_functiont &goto_function)
 
 void ai_baset::initialize(const goto_programt &goto_program)
 {
+  if(sparse_storage)
+    find_stored_locations(goto_program);
+
+  if(use_widening)
+    find_loop_heads(goto_program);
+
   // we mark everything as unreachable as starting point
 
   forall_goto_program_instructions(i_it, goto_program)
-    get_state(i_it).make_bottom();
+    if(is_stored(i_it))
+      get_state(i_it).make_bottom();
+}
+
+static void collect_widening_thresholds(
+  const exprt &expr,
+  std::set<mp_integer> &thresholds)
+{
+  if(expr.id()==ID_constant &&
+     (expr.type().id()==ID_signedbv || expr.type().id()==ID_unsignedbv))
+  {
+    mp_integer value;
+    if(!to_integer(expr, value))
+    {
+      thresholds.insert(value-1);
+      thresholds.insert(value);
+      thresholds.insert(value+1);
+    }
+  }
+
+  forall_operands(it, expr)
+    collect_widening_thresholds(*it, thresholds);
+}
+
+/// Loop heads are the headers of natural loops and, for irreducible loops,
+/// all targets of backwards jumps. Also collects the widening thresholds.
+void ai_baset::find_loop_heads(const goto_programt &goto_program)
+{
+  natural_loopst natural_loops;
+  natural_loops(goto_program);
+
+  for(const auto &loop : natural_loops.loop_map)
+    loop_heads.insert(loop.first);
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    if(i_it->is_backwards_goto())
+      for(const auto &target : i_it->targets)
+        if(target->location_number<=i_it->location_number)
+          loop_heads.insert(target);
+
+    collect_widening_thresholds(i_it->code, widening_thresholds);
+    collect_widening_thresholds(i_it->guard, widening_thresholds);
+  }
+}
+
+/// A location does not need a stored state if its only incoming edge is the
+/// fall-through from the preceding instruction, which has no other
+/// successor and is not a function call.
+void ai_baset::find_stored_locations(const goto_programt &goto_program)
+{
+  if(goto_program.instructions.empty())
+    return;
+
+  stored_locations.insert(goto_program.instructions.begin());
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    if(i_it->is_function_call() || i_it->is_end_function())
+      stored_locations.insert(i_it);
+
+    const goto_programt::const_targett next=std::next(i_it);
+    const std::list<goto_programt::const_targett> successors=
+      goto_program.get_successors(i_it);
+
+    if(successors.size()==1 &&
+       successors.front()==next &&
+       !i_it->is_function_call())
+      continue;
+
+    for(const auto &s : successors)
+      if(s!=goto_program.instructions.end())
+        stored_locations.insert(s);
+
+    if(next!=goto_program.instructions.end())
+      stored_locations.insert(next);
+  }
 }
 
 void ai_baset::initialize(const goto_functionst &goto_functions)
@@ -327,6 +411,8 @@ bool ai_baset::visit(
 {
   bool new_data=false;
 
+  number_of_visits++;
+
   statet &current=get_state(l);
 
   for(const auto &to_l : goto_program.get_successors(l))
@@ -355,6 +441,13 @@ bool ai_baset::visit(
           goto_functions, ns))
         have_new_values=true;
     }
+    else if(!is_stored(to_l))
+    {
+      new_values.transform(l, to_l, *this, ns);
+
+      if(visit_unstored(to_l, new_values, working_set, goto_program, ns))
+        new_data=true;
+    }
     else
     {
       // initialize state, if necessary
@@ -362,7 +455,7 @@ bool ai_baset::visit(
 
       new_values.transform(l, to_l, *this, ns);
 
-      if(merge(new_values, l, to_l))
+      if(merge_or_widen(new_values, l, to_l))
         have_new_values=true;
     }
 
@@ -376,6 +469,49 @@ bool ai_baset::visit(
   return new_data;
 }
 
+/// With sparse storage: transforms `state`, the state before the unstored
+/// location `l`, along the straight-line code that follows, and merges it
+/// into the states of the stored locations reached.
+bool ai_baset::visit_unstored(
+  locationt l,
+  statet &state,
+  working_sett &working_set,
+  const goto_programt &goto_program,
+  const namespacet &ns)
+{
+  std::list<locationt> successors=goto_program.get_successors(l);
+
+  while(successors.size()==1 &&
+        successors.front()!=goto_program.instructions.end() &&
+        !is_stored(successors.front()))
+  {
+    state.transform(l, successors.front(), *this, ns);
+    l=successors.front();
+    successors=goto_program.get_successors(l);
+  }
+
+  bool new_data=false;
+
+  for(const auto &to_l : successors)
+  {
+    if(to_l==goto_program.instructions.end())
+      continue;
+
+    INVARIANT(is_stored(to_l), "successors of a branch have a stored state");
+
+    std::unique_ptr<statet> tmp_state(make_temporary_state(state));
+    tmp_state->transform(l, to_l, *this, ns);
+
+    if(merge_or_widen(*tmp_state, l, to_l))
+    {
+      new_data=true;
+      put_in_working_set(working_set, to_l);
+    }
+  }
+
+  return new_data;
+}
+
 bool ai_baset::do_function_call(
   locationt l_call, locationt l_return,
   const goto_functionst &goto_functions,
@@ -395,7 +531,7 @@ bool ai_baset::do_function_call(
     std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
     tmp_state->transform(l_call, l_return, *this, ns);
 
-    return merge(*tmp_state, l_call, l_return);
+    return merge_or_widen(*tmp_state, l_call, l_return);
   }
 
   assert(!goto_function.body.instructions.empty());
@@ -415,7 +551,7 @@ bool ai_baset::do_function_call(
     bool new_data=false;
 
     // merge the new stuff
-    if(merge(*tmp_state, l_call, l_begin))
+    if(merge_or_widen(*tmp_state, l_call, l_begin))
       new_data=true;
 
     // do we need to do/re-do the fixedpoint of the body?
@@ -440,7 +576,7 @@ bool ai_baset::do_function_call(
     tmp_state->transform(l_end, l_return, *this, ns);
 
     // Propagate those
-    return merge(*tmp_state, l_end, l_return);
+    return merge_or_widen(*tmp_state, l_end, l_return);
   }
 }
 
@@ -533,6 +669,9 @@ void ai_baset::concurrent_fixedpoint(
   const goto_functionst &goto_functions,
   const namespacet &ns)
 {
+  if(sparse_storage)
+    throw "sparse state storage is not supported by concurrent analyses";
+
   sequential_fixedpoint(goto_functions, ns);
 
   is_threadedt is_threaded(goto_functions);
@@ -12,14 +12,21 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_AI_H
 #define CPROVER_ANALYSES_AI_H
 
+#include <algorithm>
 #include <iosfwd>
+#include <list>
 #include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <util/json.h>
 #include <util/xml.h>
 #include <util/expr.h>
 #include <util/make_unique.h>
+#include <util/mp_arith.h>
 
 #include <goto-programs/goto_model.h>
 
@@ -117,7 +124,11 @@ public:
   typedef ai_domain_baset statet;
   typedef goto_programt::const_targett locationt;
 
-  ai_baset()
+  ai_baset():
+    sparse_storage(false),
+    state_cache_size(0),
+    use_widening(false),
+    number_of_visits(0)
   {
   }
 
@@ -125,11 +136,26 @@ public:
   {
   }
 
+  /// Keep abstract states only at function entries and exits, function
+  /// calls and return sites, and where control flow branches or joins
+  /// (which includes all loop heads). The state before any other location
+  /// is recomputed on demand by replaying `transform` from the nearest
+  /// stored state, and the last `cache_size` recomputed states are kept.
+  /// A reference to a recomputed state remains valid until `cache_size`
+  /// further states have been recomputed. Must be set before running the
+  /// analysis; concurrent analyses do not support it.
+  void set_sparse_storage(std::size_t cache_size)
+  {
+    sparse_storage=true;
+    state_cache_size=std::max<std::size_t>(cache_size, 2);
+  }
+
   void operator()(
     const goto_programt &goto_program,
     const namespacet &ns)
   {
     goto_functionst goto_functions;
+    set_replay_namespace(ns);
     initialize(goto_program);
     entry_state(goto_program);
     fixedpoint(goto_program, goto_functions, ns);
@@ -139,6 +165,7 @@ public:
     const goto_functionst &goto_functions,
     const namespacet &ns)
   {
+    set_replay_namespace(ns);
     initialize(goto_functions);
     entry_state(goto_functions);
     fixedpoint(goto_functions, ns);
@@ -147,6 +174,7 @@ public:
   void operator()(const goto_modelt &goto_model)
   {
     const namespacet ns(goto_model.symbol_table);
+    set_replay_namespace(ns);
     initialize(goto_model.goto_functions);
     entry_state(goto_model.goto_functions);
     fixedpoint(goto_model.goto_functions, ns);
@@ -157,6 +185,7 @@ public:
     const namespacet &ns)
   {
     goto_functionst goto_functions;
+    set_replay_namespace(ns);
     initialize(goto_function);
     entry_state(goto_function.body);
     fixedpoint(goto_function.body, goto_functions, ns);
@@ -175,6 +204,23 @@ public:
 
   virtual void clear()
   {
+    stored_locations.clear();
+    loop_heads.clear();
+    widening_thresholds.clear();
+    number_of_visits=0;
+  }
+
+  /// The integer constants of the analysed program and their neighbours,
+  /// which domains may use as thresholds when widening
+  const std::set<mp_integer> &get_widening_thresholds() const
+  {
+    return widening_thresholds;
+  }
+
+  /// Number of locations visited while computing the fixed point
+  std::size_t get_number_of_visits() const
+  {
+    return number_of_visits;
   }
 
   virtual void output(
@@ -259,6 +305,37 @@ public:
   }
 
 protected:
+  bool sparse_storage;
+  std::size_t state_cache_size;
+
+  // with sparse storage: the locations that have a stored state
+  std::unordered_set<locationt, const_target_hash> stored_locations;
+
+  // with sparse storage: for recomputing states after the analysis
+  std::unique_ptr<namespacet> replay_ns;
+
+  void set_replay_namespace(const namespacet &ns)
+  {
+    if(sparse_storage)
+      replay_ns=util_make_unique<namespacet>(ns);
+  }
+
+  bool is_stored(locationt l) const
+  {
+    return !sparse_storage || stored_locations.count(l)!=0;
+  }
+
+  void find_stored_locations(const goto_programt &);
+
+  // set by widening_ait: merges into loop heads widen
+  bool use_widening;
+  std::unordered_set<locationt, const_target_hash> loop_heads;
+  std::set<mp_integer> widening_thresholds;
+
+  void find_loop_heads(const goto_programt &);
+
+  std::size_t number_of_visits;
+
   // overload to add a factory
   virtual void initialize(const goto_programt &);
   virtual void initialize(const goto_functionst::goto_functiont &);
@@ -322,6 +399,14 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  // true = found something new
+  bool visit_unstored(
+    locationt l,
+    statet &state,
+    working_sett &working_set,
+    const goto_programt &goto_program,
+    const namespacet &ns);
+
   // function calls
   bool do_function_call_rec(
     locationt l_call, locationt l_return,
@@ -337,6 +422,20 @@ protected:
     const exprt::operandst &arguments,
     const namespacet &ns);
 
+  // merge, or widen if `to' is a loop head
+  bool merge_or_widen(const statet &src, locationt from, locationt to)
+  {
+    if(use_widening && loop_heads.count(to)!=0)
+      return widen(src, from, to);
+    else
+      return merge(src, from, to);
+  }
+
+  virtual bool widen(const statet &src, locationt from, locationt to)
+  {
+    return merge(src, from, to);
+  }
+
   // abstract methods
 
   virtual bool merge(const statet &src, locationt from, locationt to)=0;
@@ -367,7 +466,7 @@ public:
   {
     typename state_mapt::iterator it=state_map.find(l);
     if(it==state_map.end())
-      throw "failed to find state";
+      return recompute_state(l);
 
     return it->second;
   }
@@ -376,7 +475,7 @@ public:
   {
     typename state_mapt::const_iterator it=state_map.find(l);
     if(it==state_map.end())
-      throw "failed to find state";
+      return recompute_state(l);
 
     return it->second;
   }
@@ -390,6 +489,8 @@ public:
   void clear() override
   {
     state_map.clear();
+    state_cache.clear();
+    state_cache_index.clear();
     ai_baset::clear();
   }
 
@@ -397,6 +498,74 @@ protected:
   typedef std::unordered_map<locationt, domainT, const_target_hash> state_mapt;
   state_mapt state_map;
 
+  // with sparse storage: recomputed states, most recently used first
+  typedef std::list<std::pair<locationt, domainT>> state_cachet;
+  mutable state_cachet state_cache;
+  mutable std::unordered_map<
+    locationt,
+    typename state_cachet::iterator,
+    const_target_hash> state_cache_index;
+
+  /// With sparse storage: the state before the unstored location `l`,
+  /// replayed from the nearest stored or cached state preceding it (the
+  /// only edge into an unstored location is the one from the preceding
+  /// instruction)
+  domainT &recompute_state(locationt l) const
+  {
+    if(!sparse_storage || is_stored(l) || !replay_ns)
+      throw "failed to find state";
+
+    typename std::unordered_map<
+      locationt,
+      typename state_cachet::iterator,
+      const_target_hash>::const_iterator c_it=state_cache_index.find(l);
+    if(c_it!=state_cache_index.end())
+    {
+      state_cache.splice(state_cache.begin(), state_cache, c_it->second);
+      return c_it->second->second;
+    }
+
+    // the locations from l back to the nearest known state
+    std::vector<locationt> path(1, l);
+    const domainT *known=nullptr;
+
+    while(known==nullptr)
+    {
+      const locationt from=std::prev(path.back());
+      path.push_back(from);
+
+      typename state_mapt::const_iterator s_it=state_map.find(from);
+      if(s_it!=state_map.end())
+        known=&s_it->second;
+      else if(is_stored(from))
+        throw "failed to find state";
+      else
+      {
+        c_it=state_cache_index.find(from);
+        if(c_it!=state_cache_index.end())
+          known=&c_it->second->second;
+      }
+    }
+
+    domainT state=*known;
+
+    // an unreachable location stays bottom
+    for(std::size_t i=path.size()-1; i>0 && !state.is_bottom(); i--)
+      state.transform(
+        path[i], path[i-1], const_cast<ait &>(*this), *replay_ns);
+
+    state_cache.push_front(std::make_pair(l, state));
+    state_cache_index[l]=state_cache.begin();
+
+    if(state_cache.size()>state_cache_size)
+    {
+      state_cache_index.erase(state_cache.back().first);
+      state_cache.pop_back();
+    }
+
+    return state_cache.front().second;
+  }
+
   // this one creates states, if need be
   virtual statet &get_state(locationt l) override
   {
@@ -408,7 +577,7 @@ protected:
   {
     typename state_mapt::const_iterator it=state_map.find(l);
     if(it==state_map.end())
-      throw "failed to find state";
+      return recompute_state(l);
 
     return it->second;
   }
@@ -447,6 +616,197 @@ private:
   }
 };
 
+/// Widens at loop heads, which makes the fixed point computation terminate
+/// quickly for domains with infinite ascending chains, and then recovers
+/// precision with descending iterations that narrow at loop heads (only when
+/// analysing goto_functions). domainT must provide
+///
+///   bool widen(const domainT &b, locationt from, locationt to,
+///              const ai_baset &ai);
+///   bool narrow(const domainT &b);
+///
+/// which return true if "this" has changed; narrow is called with a state b
+/// that is below "this".
+template<typename domainT>
+class widening_ait:public ait<domainT>
+{
+public:
+  typedef typename ait<domainT>::statet statet;
+  typedef goto_programt::const_targett locationt;
+
+  explicit widening_ait(unsigned _narrowing_passes=2):
+    ait<domainT>(),
+    narrowing_passes(_narrowing_passes)
+  {
+    this->use_widening=true;
+  }
+
+protected:
+  typedef typename ait<domainT>::state_mapt state_mapt;
+
+  const unsigned narrowing_passes;
+
+  bool widen(const statet &src, locationt from, locationt to) override
+  {
+    statet &dest=this->get_state(to);
+    return static_cast<domainT &>(dest).widen(
+      static_cast<const domainT &>(src), from, to, *this);
+  }
+
+  void fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override
+  {
+    this->sequential_fixedpoint(goto_functions, ns);
+
+    for(unsigned i=0; i<narrowing_passes; i++)
+      narrow(goto_functions, ns);
+
+    this->state_cache.clear();
+    this->state_cache_index.clear();
+  }
+
+  /// One descending iteration: every stored state is recomputed from the
+  /// states of its predecessors, and narrowed with the result at loop heads.
+  void narrow(const goto_functionst &goto_functions, const namespacet &ns)
+  {
+    const goto_functionst::function_mapt::const_iterator entry=
+      goto_functions.function_map.find(goto_functions.entry_point());
+    if(entry==goto_functions.function_map.end() ||
+       !entry->second.body_available())
+      return;
+
+    state_mapt next;
+    next[entry->second.body.instructions.begin()].make_entry();
+
+    forall_goto_functions(f_it, goto_functions)
+      forall_goto_program_instructions(i_it, f_it->second.body)
+      {
+        const typename state_mapt::const_iterator s_it=
+          this->state_map.find(i_it);
+        if(s_it!=this->state_map.end() && !s_it->second.is_bottom())
+          propagate(
+            i_it, s_it->second, f_it->second.body, goto_functions, ns, next);
+      }
+
+    for(auto &state : this->state_map)
+    {
+      const typename state_mapt::const_iterator n_it=next.find(state.first);
+
+      if(this->loop_heads.count(state.first)!=0)
+        state.second.narrow(n_it==next.end() ? domainT() : n_it->second);
+      else if(n_it==next.end())
+        state.second.make_bottom();
+      else
+        state.second=n_it->second;
+    }
+  }
+
+  /// Merges the transformation of `state`, the state before `l`, into the
+  /// successors of `l` in `next` (across straight-line code without stored
+  /// states)
+  void propagate(
+    locationt l,
+    domainT state,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns,
+    state_mapt &next)
+  {
+    std::list<locationt> successors=goto_program.get_successors(l);
+
+    while(!l->is_function_call() &&
+          successors.size()==1 &&
+          successors.front()!=goto_program.instructions.end() &&
+          !this->is_stored(successors.front()))
+    {
+      state.transform(l, successors.front(), *this, ns);
+      l=successors.front();
+      successors=goto_program.get_successors(l);
+    }
+
+    for(const auto &to_l : successors)
+    {
+      if(to_l==goto_program.instructions.end())
+        continue;
+
+      if(l->is_function_call() && !goto_functions.function_map.empty())
+      {
+        propagate_call(
+          l,
+          to_l,
+          to_code_function_call(l->code).function(),
+          state,
+          goto_functions,
+          ns,
+          next);
+      }
+      else
+      {
+        domainT tmp(state);
+        tmp.transform(l, to_l, *this, ns);
+        next[to_l].merge(tmp, l, to_l);
+      }
+    }
+  }
+
+  /// the edges of a function call, as in do_function_call_rec
+  void propagate_call(
+    locationt l_call,
+    locationt l_return,
+    const exprt &function,
+    const domainT &state,
+    const goto_functionst &goto_functions,
+    const namespacet &ns,
+    state_mapt &next)
+  {
+    if(function.id()==ID_if)
+    {
+      if(function.operands().size()!=3)
+        throw "if has three operands";
+
+      propagate_call(
+        l_call, l_return, function.op1(), state, goto_functions, ns, next);
+      propagate_call(
+        l_call, l_return, function.op2(), state, goto_functions, ns, next);
+      return;
+    }
+    else if(function.id()!=ID_symbol)
+      return;
+
+    const irep_idt &identifier=function.get(ID_identifier);
+    const goto_functionst::function_mapt::const_iterator f_it=
+      goto_functions.function_map.find(identifier);
+
+    if(f_it==goto_functions.function_map.end())
+      throw "failed to find function "+id2string(identifier);
+
+    if(!f_it->second.body_available())
+    {
+      domainT tmp(state);
+      tmp.transform(l_call, l_return, *this, ns);
+      next[l_return].merge(tmp, l_call, l_return);
+      return;
+    }
+
+    const locationt l_begin=f_it->second.body.instructions.begin();
+    domainT tmp(state);
+    tmp.transform(l_call, l_begin, *this, ns);
+    next[l_begin].merge(tmp, l_call, l_begin);
+
+    const locationt l_end=std::prev(f_it->second.body.instructions.end());
+    const typename state_mapt::const_iterator e_it=
+      this->state_map.find(l_end);
+
+    if(e_it!=this->state_map.end() && !e_it->second.is_bottom())
+    {
+      domainT end_state(e_it->second);
+      end_state.transform(l_end, l_return, *this, ns);
+      next[l_return].merge(end_state, l_end, l_return);
+    }
+  }
+};
+
 template<typename domainT>
 class concurrency_aware_ait:public ait<domainT>
 {
@@ -16,6 +16,91 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iostream>
 
+custom_bitvector_domaint::bit_vectort::wordt *
+  custom_bitvector_domaint::bit_vectort::word(unsigned bit_nr)
+{
+  if(bit_nr<word_bits)
+    return &first;
+
+  const std::size_t index=bit_nr/word_bits-1;
+  if(index>=rest.size())
+    rest.resize(index+1, 0);
+
+  return &rest[index];
+}
+
+/// removes the words above the highest bit set
+void custom_bitvector_domaint::bit_vectort::trim()
+{
+  while(!rest.empty() && rest.back()==0)
+    rest.pop_back();
+}
+
+void custom_bitvector_domaint::bit_vectort::set(unsigned bit_nr)
+{
+  *word(bit_nr)|=wordt(1)<<(bit_nr%word_bits);
+}
+
+void custom_bitvector_domaint::bit_vectort::clear(unsigned bit_nr)
+{
+  if(!get(bit_nr))
+    return;
+
+  *word(bit_nr)&=~(wordt(1)<<(bit_nr%word_bits));
+  trim();
+}
+
+bool custom_bitvector_domaint::bit_vectort::get(unsigned bit_nr) const
+{
+  wordt w;
+
+  if(bit_nr<word_bits)
+    w=first;
+  else if(bit_nr/word_bits-1<rest.size())
+    w=rest[bit_nr/word_bits-1];
+  else
+    return false;
+
+  return (w&(wordt(1)<<(bit_nr%word_bits)))!=0;
+}
+
+bool custom_bitvector_domaint::bit_vectort::unite(const bit_vectort &other)
+{
+  bool changed=(other.first&~first)!=0;
+  first|=other.first;
+
+  if(rest.size()<other.rest.size())
+    rest.resize(other.rest.size(), 0);
+
+  for(std::size_t i=0; i<other.rest.size(); i++)
+  {
+    if((other.rest[i]&~rest[i])!=0)
+      changed=true;
+    rest[i]|=other.rest[i];
+  }
+
+  return changed;
+}
+
+bool custom_bitvector_domaint::bit_vectort::intersect(
+  const bit_vectort &other)
+{
+  bool changed=(first&~other.first)!=0;
+  first&=other.first;
+
+  for(std::size_t i=0; i<rest.size(); i++)
+  {
+    const wordt other_word=i<other.rest.size()?other.rest[i]:0;
+    if((rest[i]&~other_word)!=0)
+      changed=true;
+    rest[i]&=other_word;
+  }
+
+  trim();
+
+  return changed;
+}
+
 void custom_bitvector_domaint::set_bit(
   const irep_idt &identifier,
   unsigned bit_nr,
@@ -24,19 +109,19 @@ void custom_bitvector_domaint::set_bit(
   switch(mode)
   {
   case modet::SET_MUST:
-    set_bit(must_bits[identifier], bit_nr);
+    must_bits[identifier].set(bit_nr);
     break;
 
   case modet::CLEAR_MUST:
-    clear_bit(must_bits[identifier], bit_nr);
+    must_bits[identifier].clear(bit_nr);
     break;
 
   case modet::SET_MAY:
-    set_bit(may_bits[identifier], bit_nr);
+    may_bits[identifier].set(bit_nr);
     break;
 
   case modet::CLEAR_MAY:
-    clear_bit(may_bits[identifier], bit_nr);
+    may_bits[identifier].clear(bit_nr);
     break;
   }
 }
@@ -118,12 +203,12 @@ void custom_bitvector_domaint::assign_lhs(
 {
   // we erase blank ones to avoid noise
 
-  if(vectors.must_bits==0)
+  if(vectors.must_bits.is_zero())
     must_bits.erase(identifier);
   else
     must_bits[identifier]=vectors.must_bits;
 
-  if(vectors.may_bits==0)
+  if(vectors.may_bits.is_zero())
     may_bits.erase(identifier);
   else
     may_bits[identifier]=vectors.may_bits;
@@ -351,7 +436,7 @@ void custom_bitvector_domaint::transform(
                 if(mode==modet::CLEAR_MAY)
                 {
                   for(auto &bit : may_bits)
-                    clear_bit(bit.second, bit_nr);
+                    bit.second.clear(bit_nr);
 
                   // erase blank ones
                   erase_blank_vectors(may_bits);
@@ -359,7 +444,7 @@ void custom_bitvector_domaint::transform(
                 else if(mode==modet::CLEAR_MUST)
                 {
                   for(auto &bit : must_bits)
-                    clear_bit(bit.second, bit_nr);
+                    bit.second.clear(bit_nr);
 
                   // erase blank ones
                   erase_blank_vectors(must_bits);
@@ -471,7 +556,7 @@ void custom_bitvector_domaint::transform(
               for(bitst::iterator b_it=may_bits.begin();
                   b_it!=may_bits.end();
                   b_it++)
-                clear_bit(b_it->second, bit_nr);
+                b_it->second.clear(bit_nr);
 
               // erase blank ones
               erase_blank_vectors(may_bits);
@@ -481,7 +566,7 @@ void custom_bitvector_domaint::transform(
               for(bitst::iterator b_it=must_bits.begin();
                   b_it!=must_bits.end();
                   b_it++)
-                clear_bit(b_it->second, bit_nr);
+                b_it->second.clear(bit_nr);
 
               // erase blank ones
               erase_blank_vectors(must_bits);
@@ -543,10 +628,10 @@ void custom_bitvector_domaint::output(
   for(const auto &bit : may_bits)
   {
     out << bit.first << " MAY:";
-    bit_vectort b=bit.second;
+    const bit_vectort &b=bit.second;
 
-    for(unsigned i=0; b!=0; i++, b>>=1)
-      if(b&1)
+    for(unsigned i=0; i<b.width(); i++)
+      if(b.get(i))
       {
         assert(i<cba.bits.size());
         out << ' '
@@ -559,10 +644,10 @@ void custom_bitvector_domaint::output(
   for(const auto &bit : must_bits)
   {
     out << bit.first << " MUST:";
-    bit_vectort b=bit.second;
+    const bit_vectort &b=bit.second;
 
-    for(unsigned i=0; b!=0; i++, b>>=1)
-      if(b&1)
+    for(unsigned i=0; i<b.width(); i++)
+      if(b.get(i))
       {
         assert(i<cba.bits.size());
         out << ' '
@@ -594,10 +679,7 @@ bool custom_bitvector_domaint::merge(
     }
     else if(it!=may_bits.end())
     {
-      bit_vectort &a_bits=it->second;
-      bit_vectort old=a_bits;
-      a_bits|=bit.second;
-      if(old!=a_bits)
+      if(it->second.unite(bit.second))
         changed=true;
 
       ++it;
@@ -620,10 +702,7 @@ bool custom_bitvector_domaint::merge(
     }
     else if(it!=must_bits.end())
     {
-      bit_vectort &a_bits=it->second;
-      bit_vectort old=a_bits;
-      a_bits&=bit.second;
-      if(old!=a_bits)
+      if(it->second.intersect(bit.second))
         changed=true;
 
       ++it;
@@ -644,7 +723,7 @@ void custom_bitvector_domaint::erase_blank_vectors(bitst &bits)
       a_it!=bits.end();
      ) // no a_it++
   {
-    if(a_it->second==0)
+    if(a_it->second.is_zero())
       a_it=bits.erase(a_it);
     else
       a_it++;
@@ -686,7 +765,7 @@ exprt custom_bitvector_domaint::eval(
         if(src.id()=="get_may")
         {
           for(const auto &bit : may_bits)
-            if(get_bit(bit.second, bit_nr))
+            if(bit.second.get(bit_nr))
               return true_exprt();
 
           return false_exprt();
@@ -706,9 +785,9 @@ exprt custom_bitvector_domaint::eval(
         bool value=false;
 
         if(src.id()=="get_must")
-          value=get_bit(v.must_bits, bit_nr);
+          value=v.must_bits.get(bit_nr);
         else if(src.id()=="get_may")
-          value=get_bit(v.may_bits, bit_nr);
+          value=v.may_bits.get(bit_nr);
 
         if(value)
           return true_exprt();
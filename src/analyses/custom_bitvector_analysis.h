@@ -12,6 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_CUSTOM_BITVECTOR_ANALYSIS_H
 #define CPROVER_ANALYSES_CUSTOM_BITVECTOR_ANALYSIS_H
 
+#include <cstdint>
+#include <vector>
+
 #include <util/numbering.h>
 #include <util/threeval.h>
 
@@ -74,23 +77,67 @@ public:
     locationt from,
     locationt to);
 
-  typedef unsigned long long bit_vectort;
+  /// A set of bit numbers of arbitrary size. The first 64 bits are stored
+  /// inline, the remaining ones in words that exist only up to the
+  /// highest bit set.
+  class bit_vectort
+  {
+  public:
+    bit_vectort():first(0)
+    {
+    }
+
+    bool is_zero() const
+    {
+      return first==0 && rest.empty();
+    }
+
+    void set(unsigned bit_nr);
+    void clear(unsigned bit_nr);
+    bool get(unsigned bit_nr) const;
+
+    /// adds the bits of \p other
+    /// \return true if a bit has been added
+    bool unite(const bit_vectort &other);
+
+    /// removes the bits that are not in \p other
+    /// \return true if a bit has been removed
+    bool intersect(const bit_vectort &other);
+
+    /// \return one more than the highest bit number that may be set
+    std::size_t width() const
+    {
+      return (rest.size()+1)*word_bits;
+    }
+
+    bool operator==(const bit_vectort &other) const
+    {
+      return first==other.first && rest==other.rest;
+    }
+
+  protected:
+    typedef std::uint64_t wordt;
+    static const unsigned word_bits=64;
+
+    wordt first;
+    std::vector<wordt> rest;
+
+    wordt *word(unsigned bit_nr);
+    void trim();
+  };
 
   typedef std::map<irep_idt, bit_vectort> bitst;
 
   struct vectorst
   {
     bit_vectort may_bits, must_bits;
-    vectorst():may_bits(0), must_bits(0)
-    {
-    }
   };
 
   static vectorst merge(const vectorst &a, const vectorst &b)
   {
-    vectorst result;
-    result.may_bits=a.may_bits|b.may_bits;
-    result.must_bits=a.must_bits&b.must_bits;
+    vectorst result=a;
+    result.may_bits.unite(b.may_bits);
+    result.must_bits.intersect(b.must_bits);
     return result;
   }
 
@@ -125,22 +172,6 @@ private:
   void set_bit(const exprt &, unsigned bit_nr, modet);
   void set_bit(const irep_idt &, unsigned bit_nr, modet);
 
-  static inline void set_bit(bit_vectort &dest, unsigned bit_nr)
-  {
-    dest|=(1ll<<bit_nr);
-  }
-
-  static inline void clear_bit(bit_vectort &dest, unsigned bit_nr)
-  {
-    dest|=(1ll<<bit_nr);
-    dest^=(1ll<<bit_nr);
-  }
-
-  static inline bool get_bit(const bit_vectort src, unsigned bit_nr)
-  {
-    return (src&(1ll<<bit_nr))!=0;
-  }
-
   void erase_blank_vectors(bitst &);
 
   static irep_idt object2id(const exprt &);
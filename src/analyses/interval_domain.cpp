@@ -176,10 +176,259 @@ bool interval_domaint::join(
   return result;
 }
 
+/// Sets *this to an upper bound of *this and b that, applied repeatedly,
+/// reaches a fixed point quickly: a bound of an integer variable that b
+/// exceeds is relaxed to the nearest widening threshold of the analysis,
+/// floating-point bounds are dropped.
+/// \par parameters: The interval domain, b, to widen this domain with.
+/// \return True if *this has changed.
+bool interval_domaint::widen(
+  const interval_domaint &b,
+  locationt from,
+  locationt to,
+  const ai_baset &ai)
+{
+  if(b.bottom)
+    return false;
+  if(bottom)
+  {
+    *this=b;
+    return true;
+  }
+
+  const std::set<mp_integer> &thresholds=ai.get_widening_thresholds();
+  bool result=false;
+
+  for(int_mapt::iterator it=int_map.begin();
+      it!=int_map.end(); ) // no it++
+  {
+    const int_mapt::const_iterator b_it=b.int_map.find(it->first);
+    if(b_it==b.int_map.end())
+    {
+      it=int_map.erase(it);
+      result=true;
+    }
+    else
+    {
+      integer_intervalt previous=it->second;
+      it->second.widen(b_it->second, thresholds);
+      if(it->second!=previous)
+        result=true;
+
+      it++;
+    }
+  }
+
+  const std::set<ieee_floatt> no_thresholds;
+
+  for(float_mapt::iterator it=float_map.begin();
+      it!=float_map.end(); ) // no it++
+  {
+    const float_mapt::const_iterator b_it=b.float_map.find(it->first);
+    if(b_it==b.float_map.end())
+    {
+      it=float_map.erase(it);
+      result=true;
+    }
+    else
+    {
+      ieee_float_intervalt previous=it->second;
+      it->second.widen(b_it->second, no_thresholds);
+      if(it->second!=previous)
+        result=true;
+
+      it++;
+    }
+  }
+
+  return result;
+}
+
+/// Refines *this with b, which must represent a subset of *this: the bounds
+/// missing in *this are taken from b.
+/// \par parameters: The interval domain, b, to narrow this domain with.
+/// \return True if *this has changed.
+bool interval_domaint::narrow(const interval_domaint &b)
+{
+  if(bottom)
+    return false;
+  if(b.bottom)
+  {
+    make_bottom();
+    return true;
+  }
+
+  bool result=false;
+
+  for(const auto &interval : b.int_map)
+  {
+    if(interval.second.is_top())
+      continue;
+
+    integer_intervalt &i=int_map[interval.first];
+    integer_intervalt previous=i;
+    i.narrow(interval.second);
+    if(i!=previous)
+      result=true;
+  }
+
+  for(const auto &interval : b.float_map)
+  {
+    if(interval.second.is_top())
+      continue;
+
+    ieee_float_intervalt &i=float_map[interval.first];
+    ieee_float_intervalt previous=i;
+    i.narrow(interval.second);
+    if(i!=previous)
+      result=true;
+  }
+
+  return result;
+}
+
+/// \return the values of an integer type as an interval
+static integer_intervalt type_range(const typet &type)
+{
+  integer_intervalt range;
+
+  if(type.id()==ID_signedbv)
+  {
+    range.make_ge_than(to_signedbv_type(type).smallest());
+    range.make_le_than(to_signedbv_type(type).largest());
+  }
+  else
+  {
+    range.make_ge_than(to_unsignedbv_type(type).smallest());
+    range.make_le_than(to_unsignedbv_type(type).largest());
+  }
+
+  return range;
+}
+
 void interval_domaint::assign(const code_assignt &code_assign)
 {
-  havoc_rec(code_assign.lhs());
-  assume_rec(code_assign.lhs(), ID_equal, code_assign.rhs());
+  const exprt &lhs=code_assign.lhs();
+
+  if(lhs.id()==ID_symbol && is_int(lhs.type()))
+  {
+    // evaluate before havocing, the rhs may mention the lhs
+    const integer_intervalt value=get_int_rec(code_assign.rhs());
+    const irep_idt &identifier=to_symbol_expr(lhs).get_identifier();
+
+    int_map.erase(identifier);
+
+    const integer_intervalt range=type_range(lhs.type());
+    const bool below=value.lower_set && value.lower<range.lower;
+    const bool above=value.upper_set && value.upper>range.upper;
+
+    // the value wraps around once the range of the type may be left,
+    // hence any value is possible; this holds for signed overflow as
+    // well, which is undefined, but wraps around in the program
+    if(below || above)
+      return;
+
+    // bounds at the limits of the type are kept implicit, as assume_rec
+    // does, such that half-bounded intervals are kept as such
+    integer_intervalt result;
+    if(value.lower_set && value.lower>range.lower)
+      result.make_ge_than(value.lower);
+    if(value.upper_set && value.upper<range.upper)
+      result.make_le_than(value.upper);
+
+    if(!result.is_top())
+      int_map[identifier]=result;
+
+    return;
+  }
+
+  havoc_rec(lhs);
+  assume_rec(lhs, ID_equal, code_assign.rhs());
+}
+
+/// Evaluates an integer expression over the intervals of its symbols;
+/// the result ignores overflow, which is up to the caller.
+integer_intervalt interval_domaint::get_int_rec(const exprt &expr)
+{
+  if(!is_int(expr.type()))
+    return integer_intervalt();
+
+  if(expr.id()==ID_constant)
+  {
+    mp_integer value;
+    if(to_integer(expr, value))
+      return integer_intervalt();
+    return integer_intervalt(value);
+  }
+  else if(expr.id()==ID_symbol)
+  {
+    // a missing bound is the limit of the type, which matters when the
+    // value is used in arithmetic that may overflow
+    integer_intervalt result=type_range(expr.type());
+
+    int_mapt::const_iterator it=
+      int_map.find(to_symbol_expr(expr).get_identifier());
+    if(it!=int_map.end())
+      result.meet(it->second);
+
+    return result;
+  }
+  else if(expr.id()==ID_typecast)
+  {
+    // the operand has to fit the target type, otherwise give up
+    const integer_intervalt op=get_int_rec(to_typecast_expr(expr).op());
+    const integer_intervalt range=type_range(expr.type());
+
+    if(op.lower_set && op.upper_set &&
+       op.lower>=range.lower && op.upper<=range.upper)
+      return op;
+    return integer_intervalt();
+  }
+  else if(expr.id()==ID_unary_minus)
+  {
+    const integer_intervalt op=get_int_rec(to_unary_minus_expr(expr).op());
+    integer_intervalt result;
+    if(op.upper_set)
+      result.make_ge_than(-op.upper);
+    if(op.lower_set)
+      result.make_le_than(-op.lower);
+    return result;
+  }
+  else if(expr.id()==ID_plus || expr.id()==ID_minus)
+  {
+    if(expr.operands().empty() ||
+       (expr.id()==ID_minus && expr.operands().size()!=2))
+      return integer_intervalt();
+
+    integer_intervalt result=get_int_rec(expr.op0());
+
+    for(std::size_t i=1; i<expr.operands().size(); i++)
+    {
+      const integer_intervalt op=get_int_rec(expr.operands()[i]);
+      integer_intervalt sum;
+
+      if(expr.id()==ID_plus)
+      {
+        if(result.lower_set && op.lower_set)
+          sum.make_ge_than(result.lower+op.lower);
+        if(result.upper_set && op.upper_set)
+          sum.make_le_than(result.upper+op.upper);
+      }
+      else
+      {
+        if(result.lower_set && op.upper_set)
+          sum.make_ge_than(result.lower-op.upper);
+        if(result.upper_set && op.lower_set)
+          sum.make_le_than(result.upper-op.lower);
+      }
+
+      result=sum;
+    }
+
+    return result;
+  }
+
+  return integer_intervalt();
 }
 
 void interval_domaint::havoc_rec(const exprt &lhs)
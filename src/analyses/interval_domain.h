@@ -55,6 +55,14 @@ public:
     return join(b);
   }
 
+  bool widen(
+    const interval_domaint &b,
+    locationt from,
+    locationt to,
+    const ai_baset &ai);
+
+  bool narrow(const interval_domaint &b);
+
   // no states
   void make_bottom() final override
   {
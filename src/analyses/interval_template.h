@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <algorithm>
 #include <iosfwd>
+#include <set>
 
 #include <util/threeval.h>
 
@@ -142,6 +143,49 @@ public:
     }
   }
 
+  // Widening: a bound that i exceeds is relaxed to the nearest of the
+  // given thresholds, or dropped if there is none
+  void widen(const interval_templatet &i, const std::set<T> &thresholds)
+  {
+    if(lower_set && (!i.lower_set || i.lower<lower))
+    {
+      // the largest threshold not above i.lower
+      typename std::set<T>::const_iterator t_it=
+        i.lower_set ? thresholds.upper_bound(i.lower) : thresholds.begin();
+      if(t_it==thresholds.begin())
+        lower_set=false;
+      else
+        lower=*(--t_it);
+    }
+
+    if(upper_set && (!i.upper_set || upper<i.upper))
+    {
+      // the smallest threshold not below i.upper
+      typename std::set<T>::const_iterator t_it=
+        i.upper_set ? thresholds.lower_bound(i.upper) : thresholds.end();
+      if(t_it==thresholds.end())
+        upper_set=false;
+      else
+        upper=*t_it;
+    }
+  }
+
+  // Narrowing: missing bounds are taken from i
+  void narrow(const interval_templatet &i)
+  {
+    if(!lower_set && i.lower_set)
+    {
+      lower_set=true;
+      lower=i.lower;
+    }
+
+    if(!upper_set && i.upper_set)
+    {
+      upper_set=true;
+      upper=i.upper;
+    }
+  }
+
   void approx_union_with(const interval_templatet &i)
   {
     if(i.lower_set && lower_set)
@@ -11,9 +11,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "all_properties_class.h"
 
+#include <set>
+
 #include <util/time_stopping.h>
 #include <util/xml.h>
 #include <util/json.h>
+#include <util/profiler.h>
 
 #include <solvers/sat/satcheck.h>
 #include <solvers/prop/literal_expr.h>
@@ -28,8 +31,8 @@ void bmc_all_propertiest::goal_covered(const cover_goalst::goalt &)
 {
   for(auto &g : goal_map)
   {
-    // failed already?
-    if(g.second.status==goalt::statust::FAILURE)
+    // failed already or taken from the result cache?
+    if(g.second.status!=goalt::statust::UNKNOWN)
       continue;
 
     // check whether failed
@@ -96,6 +99,25 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
     }
   }
 
+  // properties with a cached result are not passed to the solver
+  std::set<irep_idt> cached_goals;
+  if(bmc.result_cache)
+  {
+    const bool use_failures=bmc.cached_failures_usable();
+
+    for(auto &g : goal_map)
+    {
+      std::string status;
+      if(bmc.result_cache->has_result(g.first, status) &&
+         (status=="SUCCESS" || use_failures))
+      {
+        g.second.status=status=="SUCCESS" ?
+          goalt::statust::SUCCESS : goalt::statust::FAILURE;
+        cached_goals.insert(g.first);
+      }
+    }
+  }
+
   do_before_solving();
 
   cover_goalst cover_goals(solver);
@@ -105,6 +127,9 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
 
   for(const auto &g : goal_map)
   {
+    if(g.second.status!=goalt::statust::UNKNOWN)
+      continue;
+
     // Our goal is to falsify a property, i.e., we will
     // add the negation of the property as goal.
     literalt p=!solver.convert(g.second.as_expr());
@@ -115,7 +140,12 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
 
   bool error=false;
 
-  decision_proceduret::resultt result=cover_goals();
+  decision_proceduret::resultt result;
+
+  {
+    profilert::scopet profiler_scope(profiler, "solving");
+    result=cover_goals();
+  }
 
   if(result==decision_proceduret::resultt::D_ERROR)
   {
@@ -139,13 +169,30 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
              << (sat_stop-sat_start) << "s" << eom;
   }
 
+  if(bmc.result_cache)
+  {
+    for(const auto &g : goal_map)
+      if(cached_goals.find(g.first)==cached_goals.end() &&
+         (g.second.status==goalt::statust::SUCCESS ||
+          g.second.status==goalt::statust::FAILURE))
+        bmc.result_cache->store(g.first, g.second.status_string());
+
+    bmc.result_cache->write();
+
+    status() << cached_goals.size() << " of " << goal_map.size()
+             << " properties taken from result cache" << eom;
+  }
+
   // report
   report(cover_goals);
 
   if(error)
     return safety_checkert::resultt::ERROR;
 
-  bool safe=(cover_goals.number_covered()==0);
+  bool safe=true;
+  for(const auto &g : goal_map)
+    if(g.second.status==goalt::statust::FAILURE)
+      safe=false;
 
   if(safe)
     bmc.report_success(); // legacy, might go away
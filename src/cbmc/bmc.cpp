@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/message.h>
 #include <util/json.h>
 #include <util/cprover_prefix.h>
+#include <util/profiler.h>
 
 #include <langapi/mode.h>
 #include <langapi/language_util.h>
@@ -37,8 +38,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-symex/memory_model_tso.h>
 #include <goto-symex/memory_model_pso.h>
 
+#include <goto-instrument/full_slicer.h>
+
 #include "counterexample_beautification.h"
 #include "fault_localization.h"
+#include "formula_cost.h"
 
 void bmct::do_unwind_module()
 {
@@ -52,6 +56,13 @@ void bmct::error_trace()
   goto_tracet &goto_trace=safety_checkert::error_trace;
   build_goto_trace(equation, prop_conv, ns, goto_trace);
 
+  show_error_trace();
+}
+
+void bmct::show_error_trace()
+{
+  const goto_tracet &goto_trace=safety_checkert::error_trace;
+
   switch(ui)
   {
   case ui_message_handlert::uit::PLAIN:
@@ -115,13 +126,18 @@ void bmct::output_graphml(
 
 void bmct::do_conversion()
 {
+  profilert::scopet profiler_scope(profiler, "conversion");
+
   // convert HDL (hook for hw-cbmc)
   do_unwind_module();
 
   status() << "converting SSA" << eom;
 
-  // convert SSA
-  equation.convert(prop_conv);
+  // convert SSA, unless this was done during symex
+  if(equation.is_streaming())
+    equation.finish_streaming();
+  else
+    equation.convert(prop_conv);
 
   // the 'extra constraints'
   if(!bmc_constraints.empty())
@@ -131,6 +147,9 @@ void bmct::do_conversion()
     forall_expr_list(it, bmc_constraints)
       prop_conv.set_to_true(*it);
   }
+
+  profiler.set_counter("variables", prop_conv.get_number_of_variables());
+  profiler.set_counter("clauses", prop_conv.get_number_of_clauses());
 }
 
 decision_proceduret::resultt
@@ -148,7 +167,13 @@ bmct::run_decision_procedure(prop_convt &prop_conv)
 
   status() << "Running " << prop_conv.decision_procedure_text() << eom;
 
-  decision_proceduret::resultt dec_result=prop_conv.dec_solve();
+  decision_proceduret::resultt dec_result;
+
+  {
+    profilert::scopet profiler_scope(profiler, "solving");
+    dec_result=prop_conv.dec_solve();
+  }
+
   // output runtime
 
   {
@@ -333,6 +358,85 @@ safety_checkert::resultt bmct::run(
       symex.language_mode=init_symbol->mode;
   }
 
+  if(options.get_bool_option("symex-slice"))
+  {
+    if(!options.get_list_option("cover").empty())
+      warning() << "--symex-slice ignored in coverage mode" << eom;
+    else
+    {
+      status() << "Computing instructions relevant to properties" << eom;
+      symex.irrelevant_instructions=
+        full_slicer_irrelevant_instructions(goto_functions, ns);
+      statistics() << "symex slicing will skip "
+                   << symex.irrelevant_instructions.size()
+                   << " instructions" << eom;
+    }
+  }
+
+  if(!options.get_option("result-cache").empty())
+  {
+    // results are cached for the all-properties mode only
+    if(options.get_bool_option("stop-on-fail") ||
+       options.get_bool_option("incremental") ||
+       !options.get_list_option("cover").empty() ||
+       !options.get_option("localize-faults").empty() ||
+       options.get_bool_option("show-vcc") ||
+       options.get_bool_option("program-only") ||
+       options.get_bool_option("dimacs") ||
+       !options.get_option("outfile").empty())
+      warning() << "--result-cache ignored in this mode" << eom;
+    else
+    {
+      status() << "Computing property hashes for result cache" << eom;
+      result_cache=util_make_unique<result_cachet>(
+        options.get_option("result-cache"),
+        options,
+        ns,
+        get_message_handler());
+      (*result_cache)(goto_functions);
+
+      if(result_cache->complete(cached_failures_usable()) &&
+         !options.get_bool_option("unwinding-assertions") &&
+         options.get_option("symex-coverage-report").empty())
+      {
+        status() << "All properties found in result cache" << eom;
+        return all_properties(goto_functions, prop_conv);
+      }
+    }
+  }
+
+  if(options.get_bool_option("show-formula-cost"))
+  {
+    if(options.get_bool_option("incremental") ||
+       !options.get_list_option("cover").empty() ||
+       !options.get_option("localize-faults").empty())
+      warning() << "--show-formula-cost ignored in this mode" << eom;
+    else
+      equation.enable_cost_accounting(prop_conv);
+  }
+
+  if(options.get_bool_option("incremental"))
+    return run_incremental(goto_functions);
+
+  if(options.get_bool_option("stream-conversion"))
+  {
+    // these modes need the expressions of the steps after symex
+    if(!options.get_list_option("cover").empty() ||
+       !options.get_option("localize-faults").empty() ||
+       options.get_bool_option("show-vcc") ||
+       options.get_bool_option("program-only") ||
+       options.get_bool_option("beautify") ||
+       options.get_bool_option("slice-formula") ||
+       !options.get_option("slice-by-trace").empty() ||
+       !options.get_option("graphml-witness").empty())
+      warning() << "--stream-conversion ignored in this mode" << eom;
+    else
+    {
+      prop_conv.set_message_handler(get_message_handler());
+      equation.start_streaming(prop_conv);
+    }
+  }
+
   status() << "Starting Bounded Model Checking" << eom;
 
   symex.last_source_location.make_nil();
@@ -342,15 +446,20 @@ safety_checkert::resultt bmct::run(
     // get unwinding info
     setup_unwind();
 
+    profilert::scopet profiler_scope(profiler, "symex");
+
     // perform symbolic execution
     symex(goto_functions);
 
     // add a partial ordering, if required
     if(equation.has_threads())
     {
+      profilert::scopet profiler_scope(profiler, "memory model");
       memory_model->set_message_handler(get_message_handler());
       (*memory_model)(equation);
     }
+
+    profiler.set_counter("steps", equation.SSA_steps.size());
   }
 
   catch(const std::string &error_str)
@@ -385,6 +494,7 @@ safety_checkert::resultt bmct::run(
   {
     if(options.get_option("slice-by-trace")!="")
     {
+      profilert::scopet profiler_scope(profiler, "slicing");
       symex_slice_by_tracet symex_slice_by_trace(ns);
 
       symex_slice_by_trace.slice_by_trace
@@ -396,10 +506,16 @@ safety_checkert::resultt bmct::run(
       // we should build a thread-aware SSA slicer
       statistics() << "no slicing due to threads" << eom;
     }
+    else if(equation.is_streaming())
+    {
+      // the steps have been converted already
+      statistics() << "no slicing due to streaming conversion" << eom;
+    }
     else
     {
       if(options.get_bool_option("slice-formula"))
       {
+        profilert::scopet profiler_scope(profiler, "slicing");
         slice(equation);
         statistics() << "slicing removed "
                      << equation.count_ignored_SSA_steps()
@@ -409,6 +525,7 @@ safety_checkert::resultt bmct::run(
       {
         if(options.get_list_option("cover").empty())
         {
+          profilert::scopet profiler_scope(profiler, "slicing");
           simple_slice(equation);
           statistics() << "simple slicing removed "
                        << equation.count_ignored_SSA_steps()
@@ -423,6 +540,11 @@ safety_checkert::resultt bmct::run(
                    << " remaining after simplification" << eom;
     }
 
+    if(options.get_bool_option("symex-summaries"))
+      statistics() << "Reused the results of "
+                   << symex.reused_function_calls
+                   << " function call(s)" << eom;
+
     // coverage report
     std::string cov_out=options.get_option("symex-coverage-report");
     if(!cov_out.empty() &&
@@ -496,10 +618,29 @@ safety_checkert::resultt bmct::decide(
 {
   prop_conv.set_message_handler(get_message_handler());
 
-  if(options.get_bool_option("stop-on-fail"))
-    return stop_on_fail(goto_functions, prop_conv);
+  const resultt result=
+    options.get_bool_option("stop-on-fail")?
+      stop_on_fail(goto_functions, prop_conv):
+      all_properties(goto_functions, prop_conv);
+
+  if(options.get_bool_option("show-formula-cost"))
+    show_formula_cost(goto_functions, prop_conv);
+
+  return result;
+}
+
+/// outputs the size of the formula per source line, function and loop
+void bmct::show_formula_cost(
+  const goto_functionst &goto_functions,
+  const prop_convt &prop_conv)
+{
+  json_objectt json;
+  json["formulaCost"]=formula_cost_json(equation, prop_conv, goto_functions);
+
+  if(ui==ui_message_handlert::uit::JSON_UI)
+    std::cout << ",\n" << json;
   else
-    return all_properties(goto_functions, prop_conv);
+    std::cout << json << '\n';
 }
 
 safety_checkert::resultt bmct::stop_on_fail(
@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <list>
 #include <map>
+#include <memory>
 
 #include <util/options.h>
 #include <util/ui_message.h>
@@ -28,6 +29,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-symex/symex_target_equation.h>
 #include <goto-programs/safety_checker.h>
 
+#include "result_cache.h"
 #include "symex_bmc.h"
 
 class bmct:public safety_checkert
@@ -77,9 +79,24 @@ protected:
   // use gui format
   ui_message_handlert::uit ui;
 
+  // set up by run() if --result-cache is given
+  std::unique_ptr<result_cachet> result_cache;
+
+  /// Cached FAILURE results come without a trace, so they are only used
+  /// when no trace is to be shown.
+  bool cached_failures_usable() const
+  {
+    return ui==ui_message_handlert::uit::PLAIN &&
+           !options.get_bool_option("trace");
+  }
+
   virtual decision_proceduret::resultt
     run_decision_procedure(prop_convt &prop_conv);
 
+  // incremental loop deepening, see bmc_incremental.cpp
+  virtual resultt run_incremental(const goto_functionst &goto_functions);
+  decision_proceduret::resultt solve_under_assumption(const exprt &);
+
   virtual resultt decide(
     const goto_functionst &,
     prop_convt &);
@@ -100,10 +117,14 @@ protected:
     const goto_functionst &goto_functions,
     prop_convt &solver);
   virtual void show_program();
+  void show_formula_cost(
+    const goto_functionst &goto_functions,
+    const prop_convt &prop_conv);
   virtual void report_success();
   virtual void report_failure();
 
   virtual void error_trace();
+  void show_error_trace();
   void output_graphml(
     resultt result,
     const goto_functionst &goto_functions);
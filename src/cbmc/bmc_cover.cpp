@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/xml_expr.h>
 #include <util/json.h>
 #include <util/json_expr.h>
+#include <util/profiler.h>
 
 #include <solvers/prop/cover_goals.h>
 #include <solvers/prop/literal_expr.h>
@@ -249,7 +250,10 @@ bool bmc_covert::operator()()
 
   status() << "Running " << solver.decision_procedure_text() << eom;
 
-  cover_goals();
+  {
+    profilert::scopet profiler_scope(profiler, "solving");
+    cover_goals();
+  }
 
   // output runtime
 
@@ -0,0 +1,317 @@
+/*******************************************************************\
+
+Module: Incremental Bounded Model Checking
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Incremental Bounded Model Checking
+///
+/// Loops are unwound one iteration at a time. In each round, symex
+/// continues the paths that were paused at the loop bound of the previous
+/// round, and the new SSA steps are added to the same solver instance.
+/// The properties are checked first; if they hold, the unwinding
+/// assertions of the round tell whether any path can go on iterating.
+
+#include "bmc.h"
+
+#include <util/profiler.h>
+#include <util/string2int.h>
+#include <util/time_stopping.h>
+
+#include <solvers/prop/literal_expr.h>
+
+#include <goto-symex/build_goto_trace.h>
+
+/// Records the highest L2 index of each variable, as found in the
+/// assignments and declarations from \p first onwards and in \p state.
+static void update_l2_counts(
+  symex_target_equationt::SSA_stepst::const_iterator first,
+  symex_target_equationt::SSA_stepst::const_iterator last,
+  const symex_bmct::statet &state,
+  symex_bmct::statet::level2t::current_namest &l2_counts)
+{
+  for(auto it=first; it!=last; ++it)
+  {
+    if(!it->is_assignment() && !it->is_decl())
+      continue;
+
+    ssa_exprt l1_expr=it->ssa_lhs;
+    const unsigned count=
+      safe_string2unsigned(id2string(l1_expr.get_level_2()));
+    l1_expr.remove_level_2();
+
+    auto entry=l2_counts.insert(
+      std::make_pair(l1_expr.get_identifier(), std::make_pair(l1_expr, 0)));
+    if(entry.first->second.second<count)
+      entry.first->second.second=count;
+  }
+
+  // DEAD instructions increase counters without adding steps
+  for(const auto &name : state.level2.current_names)
+  {
+    auto entry=l2_counts.insert(name);
+    if(entry.first->second.second<name.second.second)
+      entry.first->second.second=name.second.second;
+  }
+}
+
+decision_proceduret::resultt bmct::solve_under_assumption(
+  const exprt &condition)
+{
+  literalt l=prop_conv.convert(condition);
+
+  if(l.is_false())
+    return decision_proceduret::resultt::D_UNSATISFIABLE;
+
+  bvt assumptions;
+  assumptions.push_back(l);
+  prop_conv.set_assumptions(assumptions);
+
+  status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+  absolute_timet sat_start=current_time();
+
+  decision_proceduret::resultt dec_result;
+
+  {
+    profilert::scopet profiler_scope(profiler, "solving");
+    dec_result=prop_conv.dec_solve();
+  }
+
+  {
+    absolute_timet sat_stop=current_time();
+    status() << "Runtime decision procedure: "
+             << (sat_stop-sat_start) << "s" << eom;
+  }
+
+  return dec_result;
+}
+
+safety_checkert::resultt bmct::run_incremental(
+  const goto_functionst &goto_functions)
+{
+  if(!prop_conv.has_set_assumptions())
+  {
+    error() << "sorry, this solver does not support incremental BMC" << eom;
+    return safety_checkert::resultt::ERROR;
+  }
+
+  if(options.get_bool_option("show-vcc") ||
+     options.get_bool_option("program-only") ||
+     options.get_bool_option("slice-formula") ||
+     options.get_bool_option("beautify") ||
+     !options.get_option("slice-by-trace").empty() ||
+     !options.get_option("localize-faults").empty() ||
+     !options.get_option("symex-coverage-report").empty())
+    warning() << "incremental BMC ignores --show-vcc, --program-only, "
+              << "--beautify, --localize-faults, coverage reports and slicing"
+              << eom;
+
+  const std::string &loop_id=options.get_option("incremental-check");
+  if(loop_id.empty())
+    symex.set_incremental_all_loops();
+  else
+    symex.set_incremental_loop(loop_id);
+
+  const unsigned unwind_min=
+    options.get_option("unwind-min").empty()?
+      1:options.get_unsigned_int_option("unwind-min");
+
+  // zero stands for no maximum
+  const unsigned unwind_max=
+    options.get_option("unwind-max").empty()?
+      0:options.get_unsigned_int_option("unwind-max");
+
+  if(unwind_max!=0 && unwind_min>unwind_max)
+  {
+    error() << "--unwind-min must not exceed --unwind-max" << eom;
+    return safety_checkert::resultt::ERROR;
+  }
+
+  goto_functionst::function_mapt::const_iterator entry=
+    goto_functions.function_map.find(goto_functionst::entry_point());
+
+  if(entry==goto_functions.function_map.end())
+  {
+    error() << "the program has no entry point" << eom;
+    return safety_checkert::resultt::ERROR;
+  }
+
+  status() << "Starting Incremental Bounded Model Checking" << eom;
+
+  prop_conv.set_message_handler(get_message_handler());
+  symex.last_source_location.make_nil();
+
+  // the state of the path that symex executed last
+  symex_bmct::paused_statest previous_state(1);
+  symex_bmct::statet::level2t::current_namest l2_counts;
+  std::size_t counted_steps=0;
+
+  for(unsigned bound=unwind_min; ; bound++)
+  {
+    const bool last_round=unwind_max!=0 && bound>=unwind_max;
+    symex.set_incremental_bound(bound, last_round);
+
+    status() << "Unwinding with bound " << bound << eom;
+
+    try
+    {
+      if(bound==unwind_min)
+      {
+        setup_unwind();
+        symex(previous_state.front(), goto_functions, entry->second.body);
+      }
+      else
+      {
+        symex_bmct::paused_statest resumed;
+        resumed.swap(symex.paused_states);
+
+        while(!resumed.empty())
+        {
+          update_l2_counts(
+            equation.get_SSA_step(counted_steps),
+            equation.SSA_steps.end(),
+            previous_state.front(),
+            l2_counts);
+          counted_steps=equation.SSA_steps.size();
+
+          symex.resume(
+            resumed.front(),
+            previous_state.front(),
+            l2_counts,
+            goto_functions);
+
+          previous_state.splice(
+            previous_state.begin(), resumed, resumed.begin());
+          previous_state.pop_back();
+        }
+      }
+    }
+
+    catch(const std::string &error_str)
+    {
+      messaget message(get_message_handler());
+      message.error().source_location=symex.last_source_location;
+      message.error() << error_str << messaget::eom;
+
+      return safety_checkert::resultt::ERROR;
+    }
+
+    catch(const char *error_str)
+    {
+      messaget message(get_message_handler());
+      message.error().source_location=symex.last_source_location;
+      message.error() << error_str << messaget::eom;
+
+      return safety_checkert::resultt::ERROR;
+    }
+
+    catch(std::bad_alloc)
+    {
+      error() << "Out of memory" << eom;
+      return safety_checkert::resultt::ERROR;
+    }
+
+    if(equation.has_threads())
+    {
+      error() << "sorry, incremental BMC does not support threads" << eom;
+      return safety_checkert::resultt::ERROR;
+    }
+
+    statistics() << "size of program expression: "
+                 << equation.SSA_steps.size()
+                 << " steps" << eom;
+
+    status() << "converting SSA" << eom;
+
+    symex_target_equationt::SSA_stepst::iterator first_new_step;
+
+    {
+      profilert::scopet profiler_scope(profiler, "conversion");
+      first_new_step=equation.convert_incremental(prop_conv);
+    }
+
+    if(bound==unwind_min)
+      forall_expr_list(it, bmc_constraints)
+        prop_conv.set_to_true(*it);
+
+    // Properties that were checked in earlier rounds still hold, as the
+    // formula has only grown. Unwinding assertions are properties only
+    // in the last round.
+    exprt::operandst property_failures, unwinding_failures;
+
+    for(auto it=first_new_step; it!=equation.SSA_steps.end(); ++it)
+      if(it->is_assert())
+      {
+        if(!last_round && it->source.pc->is_goto())
+          unwinding_failures.push_back(literal_exprt(!it->cond_literal));
+        else
+          property_failures.push_back(literal_exprt(!it->cond_literal));
+      }
+
+    statistics() << property_failures.size() << " new properties, "
+                 << unwinding_failures.size() << " unwinding assertions"
+                 << eom;
+
+    switch(solve_under_assumption(disjunction(property_failures)))
+    {
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      break;
+
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      if(options.get_bool_option("trace"))
+      {
+        auto stop=first_new_step;
+        while(stop!=equation.SSA_steps.end() &&
+              (!stop->is_assert() ||
+               (!last_round && stop->source.pc->is_goto()) ||
+               !prop_conv.l_get(stop->cond_literal).is_false()))
+          ++stop;
+        assert(stop!=equation.SSA_steps.end());
+
+        status() << "Building error trace" << eom;
+        build_goto_trace(
+          equation, stop, prop_conv, ns, safety_checkert::error_trace);
+        show_error_trace();
+        output_graphml(resultt::UNSAFE, goto_functions);
+      }
+
+      report_failure();
+      return safety_checkert::resultt::UNSAFE;
+
+    default:
+      error() << "decision procedure failed" << eom;
+      return safety_checkert::resultt::ERROR;
+    }
+
+    if(unwinding_failures.empty())
+    {
+      status() << "No path exceeds bound " << bound << eom;
+      break;
+    }
+
+    switch(solve_under_assumption(disjunction(unwinding_failures)))
+    {
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      status() << "No path exceeds bound " << bound << eom;
+      symex.paused_states.clear();
+      report_success();
+      output_graphml(resultt::SAFE, goto_functions);
+      return safety_checkert::resultt::SAFE;
+
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      break;
+
+    default:
+      error() << "decision procedure failed" << eom;
+      return safety_checkert::resultt::ERROR;
+    }
+  }
+
+  report_success();
+  output_graphml(resultt::SAFE, goto_functions);
+  return safety_checkert::resultt::SAFE;
+}
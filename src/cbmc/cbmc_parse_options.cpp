@@ -22,6 +22,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/unicode.h>
 #include <util/memory_info.h>
 #include <util/invariant.h>
+#include <util/profiler.h>
+#include <util/string_container.h>
 #include <util/exit_codes.h>
 
 #include <ansi-c/c_preprocess.h>
@@ -156,6 +158,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
      cmdline.isset("stop-on-fail"))
     options.set_option("trace", true);
 
+  if(cmdline.isset("result-cache"))
+    options.set_option("result-cache", cmdline.get_value("result-cache"));
+
   if(cmdline.isset("localize-faults"))
     options.set_option("localize-faults", true);
   if(cmdline.isset("localize-faults-method"))
@@ -168,6 +173,53 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
+  // incremental loop deepening
+  if(cmdline.isset("incremental") ||
+     cmdline.isset("incremental-check"))
+  {
+    if(cmdline.isset("cover") ||
+       cmdline.isset("all-properties") ||
+       cmdline.isset("all-claims"))
+    {
+      error() << "--incremental-check cannot be used with "
+              << "--cover or --all-properties" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("incremental", true);
+  }
+
+  if(cmdline.isset("incremental-check"))
+    options.set_option(
+      "incremental-check", cmdline.get_value("incremental-check"));
+
+  if(cmdline.isset("unwind-min"))
+    options.set_option("unwind-min", cmdline.get_value("unwind-min"));
+
+  if(cmdline.isset("unwind-max"))
+    options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+
+  if(cmdline.isset("stream-conversion"))
+    options.set_option("stream-conversion", true);
+
+  if(cmdline.isset("symex-summaries"))
+    options.set_option("symex-summaries", true);
+
+  if(cmdline.isset("bdd-guards"))
+    options.set_option("bdd-guards", true);
+
+  if(cmdline.isset("show-formula-cost"))
+  {
+    // the cost report is JSON only
+    if(cmdline.isset("xml-ui"))
+    {
+      error() << "--show-formula-cost cannot be used with --xml-ui" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("show-formula-cost", true);
+  }
+
   if(cmdline.isset("depth"))
     options.set_option("depth", cmdline.get_value("depth"));
 
@@ -233,6 +285,11 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  // do not generate unused equations in the first place
+  options.set_option(
+    "symex-slice",
+    cmdline.isset("symex-slice"));
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -390,6 +447,10 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("sat-preprocessor", true);
 
+  options.set_option(
+    "structural-hashing",
+    cmdline.isset("structural-hashing"));
+
   options.set_option(
     "pretty-names",
     !cmdline.isset("no-pretty-names"));
@@ -443,6 +504,9 @@ int cbmc_parse_optionst::doit()
 
   eval_verbosity();
 
+  if(cmdline.isset("profile-json"))
+    profiler.enable();
+
   //
   // Print a banner
   //
@@ -730,44 +794,89 @@ void cbmc_parse_optionst::preprocessing()
 bool cbmc_parse_optionst::process_goto_program(
   const optionst &options)
 {
+  profilert::scopet profiler_scope(profiler, "instrumentation");
+
   try
   {
     // Remove inline assembler; this needs to happen before
     // adding the library.
-    remove_asm(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "remove asm");
+      remove_asm(goto_model);
+    }
 
     // add the library
-    link_to_library(goto_model, get_message_handler());
+    {
+      profilert::scopet profiler_scope(profiler, "link to library");
+      link_to_library(goto_model, get_message_handler());
+    }
 
     if(cmdline.isset("string-abstraction"))
+    {
+      profilert::scopet profiler_scope(profiler, "string instrumentation");
       string_instrumentation(goto_model, get_message_handler());
+    }
 
     // remove function pointers
     status() << "Removal of function pointers and virtual functions" << eom;
-    remove_function_pointers(
-      get_message_handler(),
-      goto_model,
-      cmdline.isset("pointer-check"));
+    {
+      profilert::scopet profiler_scope(profiler, "remove function pointers");
+      remove_function_pointers(
+        get_message_handler(),
+        goto_model,
+        cmdline.isset("pointer-check"));
+    }
     // remove catch and throw (introduces instanceof)
-    remove_exceptions(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "remove exceptions");
+      remove_exceptions(goto_model);
+    }
 
-    mm_io(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "mm io");
+      mm_io(goto_model);
+    }
 
     // instrument library preconditions
-    instrument_preconditions(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "instrument preconditions");
+      instrument_preconditions(goto_model);
+    }
+
+    // The passes below walk the function map one after the other, on one
+    // thread: irept reference counts and the string container are not
+    // thread-safe, and even function-local passes share type ireps.
 
     // remove returns, gcc vectors, complex
-    remove_returns(goto_model);
-    remove_vector(goto_model);
-    remove_complex(goto_model);
-    rewrite_union(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "remove returns");
+      remove_returns(goto_model);
+    }
+    {
+      profilert::scopet profiler_scope(profiler, "remove vector");
+      remove_vector(goto_model);
+    }
+    {
+      profilert::scopet profiler_scope(profiler, "remove complex");
+      remove_complex(goto_model);
+    }
+    {
+      profilert::scopet profiler_scope(profiler, "rewrite union");
+      rewrite_union(goto_model);
+    }
 
     // add generic checks
     status() << "Generic Property Instrumentation" << eom;
-    goto_check(options, goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "goto check");
+      goto_check(options, goto_model);
+    }
 
     // checks don't know about adjusted float expressions
-    adjust_float_expressions(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "adjust float expressions");
+      adjust_float_expressions(goto_model);
+    }
 
     // ignore default/user-specified initialization
     // of variables with static lifetime
@@ -775,12 +884,14 @@ bool cbmc_parse_optionst::process_goto_program(
     {
       status() << "Adding nondeterministic initialization "
                   "of static/global variables" << eom;
+      profilert::scopet profiler_scope(profiler, "nondet static");
       nondet_static(goto_model);
     }
 
     if(cmdline.isset("string-abstraction"))
     {
       status() << "String Abstraction" << eom;
+      profilert::scopet profiler_scope(profiler, "string abstraction");
       string_abstraction(
         goto_model,
         get_message_handler());
@@ -800,16 +911,21 @@ bool cbmc_parse_optionst::process_goto_program(
     {
       // Entry point will have been set before and function pointers removed
       status() << "Removing unused functions" << eom;
+      profilert::scopet profiler_scope(profiler, "remove unused functions");
       remove_unused_functions(goto_model, get_message_handler());
     }
 
     // remove skips such that trivial GOTOs are deleted and not considered
     // for coverage annotation:
-    remove_skip(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "remove skip");
+      remove_skip(goto_model);
+    }
 
     // instrument cover goals
     if(cmdline.isset("cover"))
     {
+      profilert::scopet profiler_scope(profiler, "cover instrumentation");
       if(instrument_cover_goals(
            cmdline,
            goto_model,
@@ -828,6 +944,7 @@ bool cbmc_parse_optionst::process_goto_program(
     if(cmdline.isset("full-slice"))
     {
       status() << "Performing a full slice" << eom;
+      profilert::scopet profiler_scope(profiler, "full slice");
       if(cmdline.isset("property"))
         property_slicer(goto_model, cmdline.get_values("property"));
       else
@@ -835,7 +952,22 @@ bool cbmc_parse_optionst::process_goto_program(
     }
 
     // remove any skips introduced since coverage instrumentation
-    remove_skip(goto_model);
+    {
+      profilert::scopet profiler_scope(profiler, "remove skip");
+      remove_skip(goto_model);
+    }
+
+    if(profiler.is_enabled())
+    {
+      irep_node_countert count_irep_nodes;
+      forall_goto_functions(f_it, goto_model.goto_functions)
+        forall_goto_program_instructions(i_it, f_it->second.body)
+        {
+          count_irep_nodes(i_it->code);
+          count_irep_nodes(i_it->guard);
+        }
+      profiler.set_counter("gotoProgramIrepNodes", count_irep_nodes.count());
+    }
   }
 
   catch(const char *e)
@@ -892,9 +1024,35 @@ int cbmc_parse_optionst::do_bmc(bmct &bmc)
   memory_info(debug());
   debug() << eom;
 
+  if(cmdline.isset("profile-json"))
+    output_profile(cmdline.get_value("profile-json"));
+
   return result;
 }
 
+/// writes the profile of this run to \p file_name, or to the standard
+/// output if it is "-"
+void cbmc_parse_optionst::output_profile(const std::string &file_name)
+{
+  profiler.set_counter("stringContainerSize", string_container.size());
+
+  json_objectt json;
+  json["profile"]=profiler.to_json();
+
+  if(file_name=="-")
+    std::cout << json << '\n';
+  else
+  {
+    std::ofstream out(file_name);
+    if(!out)
+    {
+      error() << "failed to write profile to `" << file_name << "'" << eom;
+      return;
+    }
+    out << json << '\n';
+  }
+}
+
 /// display command line help
 void cbmc_parse_optionst::help()
 {
@@ -923,6 +1081,7 @@ void cbmc_parse_optionst::help()
     " --property id                only check one specific property\n"
     " --stop-on-fail               stop analysis once a failed property is detected\n" // NOLINT(*)
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
+    " --result-cache file          reuse and record results of unchanged properties\n" // NOLINT(*)
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -969,6 +1128,8 @@ void cbmc_parse_optionst::help()
     " --show-symbol-table          show symbol table\n"
     HELP_SHOW_GOTO_FUNCTIONS
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
+    " --convert-only-reachable     only generate goto code for functions reachable\n" // NOLINT(*)
+    "                              from the entry point\n"
     "\n"
     "Program instrumentation options:\n"
     HELP_GOTO_CHECK
@@ -989,8 +1150,18 @@ void cbmc_parse_optionst::help()
     " --unwind nr                  unwind nr times\n"
     " --unwindset L:B,...          unwind loop L with a bound of B\n"
     "                              (use --show-loops to get the loop IDs)\n"
+    " --incremental-check L        unwind loop L incrementally until a property\n" // NOLINT(*)
+    "                              fails or the loop is fully unwound\n"
+    " --incremental                unwind all loops incrementally\n"
+    " --unwind-min nr              start incremental unwinding at bound nr\n"
+    " --unwind-max nr              stop incremental unwinding at bound nr\n"
     " --show-vcc                   show the verification conditions\n"
     " --slice-formula              remove assignments unrelated to property\n"
+    " --symex-slice                skip instructions unrelated to property\n"
+    "                              during symbolic execution\n"
+    " --stream-conversion          convert the formula during symbolic execution\n" // NOLINT(*)
+    " --symex-summaries            reuse the results of calls with the same inputs\n" // NOLINT(*)
+    " --bdd-guards                 merge the guards of branches using BDDs\n"
     " --unwinding-assertions       generate unwinding assertions\n"
     " --partial-loops              permit paths with partial loops\n"
     " --no-pretty-names            do not simplify identifiers\n"
@@ -999,6 +1170,8 @@ void cbmc_parse_optionst::help()
     "Backend options:\n"
     " --object-bits n              number of bits used for object addresses\n"
     " --dimacs                     generate CNF in DIMACS format\n"
+    " --show-formula-cost          show the formula size per line, function and loop\n" // NOLINT(*)
+    " --profile-json file          write time and memory per phase to file in JSON\n" // NOLINT(*)
     " --beautify                   beautify the counterexample (greedy heuristic)\n" // NOLINT(*)
     " --localize-faults            localize faults (experimental)\n"
     " --smt1                       use default SMT1 solver (obsolete)\n"
@@ -1017,6 +1190,10 @@ void cbmc_parse_optionst::help()
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --structural-hashing         share identical gates in the CNF encoding\n"
+    " --aig                        simplify the formula as and-inverter graph\n"
+    "                              before converting it to CNF\n"
+    "                              (requires --stop-on-fail)\n"
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
@@ -28,6 +28,9 @@ class optionst;
   "(program-only)(preprocess)(slice-by-trace):" \
   OPT_FUNCTIONS \
   "(no-simplify)(unwind):(unwindset):(slice-formula)(full-slice)" \
+  "(incremental)(incremental-check):(unwind-min):(unwind-max):" \
+  "(symex-slice)(stream-conversion)(symex-summaries)(bdd-guards)" \
+  "(show-formula-cost)(profile-json):" \
   "(debug-level):(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(outfile):(test-preprocessor)" \
   "D:I:(c89)(c99)(c11)(cpp98)(cpp03)(cpp11)" \
@@ -38,7 +41,7 @@ class optionst;
   "(no-built-in-assertions)" \
   "(xml-ui)(xml-interface)(json-ui)" \
   "(smt1)(smt2)(fpa)(cvc3)(cvc4)(boolector)(yices)(z3)(opensmt)(mathsat)" \
-  "(no-sat-preprocessor)" \
+  "(no-sat-preprocessor)(structural-hashing)" \
   "(no-pretty-names)(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
   "(refine-strings)" \
@@ -52,7 +55,8 @@ class optionst;
   "(show-symbol-table)(show-parse-tree)(show-vcc)" \
   "(show-claims)(claim):(show-properties)" \
   "(drop-unused-functions)" \
-  "(property):(stop-on-fail)(trace)" \
+  "(convert-only-reachable)" \
+  "(property):(stop-on-fail)(trace)(result-cache):" \
   "(error-label):(verbosity):(no-library)" \
   "(nondet-static)" \
   "(version)" \
@@ -94,6 +98,7 @@ protected:
   bool process_goto_program(const optionst &);
   bool set_properties();
   int do_bmc(bmct &);
+  void output_profile(const std::string &file_name);
 };
 
 #endif // CPROVER_CBMC_CBMC_PARSE_OPTIONS_H
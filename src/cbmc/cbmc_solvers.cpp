@@ -92,16 +92,41 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
 {
   auto solver=util_make_unique<solvert>();
 
+  std::unique_ptr<cnft> sat;
+
   if(options.get_bool_option("beautify") ||
+     options.get_bool_option("incremental") ||
      !options.get_bool_option("sat-preprocessor")) // no simplifier
   {
-    // simplifier won't work with beautification
-    solver->set_prop(util_make_unique<satcheck_no_simplifiert>());
+    // simplifier won't work with beautification, and would eliminate
+    // variables that incremental BMC refers to in later rounds
+    sat=util_make_unique<satcheck_no_simplifiert>();
   }
   else // with simplifier
   {
-    solver->set_prop(util_make_unique<satcheckt>());
+    sat=util_make_unique<satcheckt>();
+  }
+
+  sat->set_structural_hashing(options.get_bool_option("structural-hashing"));
+
+  if(options.get_bool_option("aig"))
+  {
+    // the AIG is converted into CNF at the first call to the solver, and
+    // then discarded; neither the node numbering nor the single-polarity
+    // encoding carries over to a second call, which all-properties mode
+    // would make
+    no_beautification();
+    no_incremental_check();
+
+    if(!options.get_bool_option("stop-on-fail"))
+      throw "sorry, --aig requires --stop-on-fail";
+
+    auto aig=util_make_unique<aig_prop_solvert>(*sat);
+    solver->set_backend_prop(std::move(sat));
+    solver->set_prop(std::move(aig));
   }
+  else
+    solver->set_prop(std::move(sat));
 
   solver->prop().set_message_handler(get_message_handler());
 
@@ -112,6 +137,9 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
   else if(options.get_option("arrays-uf")=="always")
     bv_cbmc->unbounded_array=bv_cbmct::unbounded_arrayt::U_ALL;
 
+  // incremental BMC adds to the formula after each call to the solver
+  bv_cbmc->repeat_post_processing=options.get_bool_option("incremental");
+
   solver->set_prop_conv(std::move(bv_cbmc));
 
   return solver;
@@ -124,6 +152,7 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_dimacs()
 
   auto prop=util_make_unique<dimacs_cnft>();
   prop->set_message_handler(get_message_handler());
+  prop->set_structural_hashing(options.get_bool_option("structural-hashing"));
 
   std::string filename=options.get_option("outfile");
 
@@ -133,6 +162,8 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_dimacs()
 
 std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_bv_refinement()
 {
+  no_incremental_bmc();
+
   std::unique_ptr<propt> prop=[this]() -> std::unique_ptr<propt>
   {
     // We offer the option to disable the SAT preprocessor
@@ -169,6 +200,8 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_bv_refinement()
 /// \return a solver for cbmc
 std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_string_refinement()
 {
+  no_incremental_bmc();
+
   string_refinementt::infot info;
   info.ns=&ns;
   auto prop=util_make_unique<satcheck_no_simplifiert>();
@@ -351,9 +384,18 @@ void cbmc_solverst::no_incremental_check()
 {
   if(options.get_bool_option("all-properties") ||
      options.get_option("cover")!="" ||
-     options.get_option("incremental-check")!="")
+     options.get_bool_option("incremental"))
   {
     error() << "sorry, this solver does not support incremental solving" << eom;
     throw 0;
   }
 }
+
+void cbmc_solverst::no_incremental_bmc()
+{
+  if(options.get_bool_option("incremental"))
+  {
+    error() << "sorry, this solver does not support incremental BMC" << eom;
+    throw 0;
+  }
+}
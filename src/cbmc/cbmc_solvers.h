@@ -97,8 +97,15 @@ public:
       ofstream_ptr=std::move(p);
     }
 
+    // solver that prop() forwards to, e.g., the SAT solver behind an AIG
+    void set_backend_prop(std::unique_ptr<propt> p)
+    {
+      backend_prop_ptr=std::move(p);
+    }
+
     // the objects are deleted in the opposite order they appear below
     std::unique_ptr<std::ofstream> ofstream_ptr;
+    std::unique_ptr<propt> backend_prop_ptr;
     std::unique_ptr<propt> prop_ptr;
     std::unique_ptr<prop_convt> prop_conv_ptr;
   };
@@ -146,6 +153,7 @@ protected:
   // consistency checks during solver creation
   void no_beautification();
   void no_incremental_check();
+  void no_incremental_bmc();
 };
 
 #endif // CPROVER_CBMC_CBMC_SOLVERS_H
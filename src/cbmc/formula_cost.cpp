@@ -0,0 +1,212 @@
+/*******************************************************************\
+
+Module: Attribution of the Formula Size to the Program
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Attribution of the Formula Size to the Program
+
+#include "formula_cost.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <util/json_expr.h>
+
+#include <solvers/prop/prop_conv.h>
+
+namespace
+{
+struct costt
+{
+  costt():
+    steps(0),
+    variables(0),
+    clauses(0),
+    time(std::chrono::steady_clock::duration::zero())
+  {
+  }
+
+  void add(const symex_target_equationt::conversion_costt &cost)
+  {
+    ++steps;
+    variables+=cost.variables;
+    clauses+=cost.clauses;
+    time+=cost.time;
+  }
+
+  std::size_t steps;
+  std::size_t variables;
+  std::size_t clauses;
+  std::chrono::steady_clock::duration time;
+};
+
+struct loopt
+{
+  unsigned begin, end;
+  irep_idt id;
+};
+
+typedef std::map<irep_idt, std::vector<loopt>> loopst;
+
+typedef std::pair<const json_objectt *, const costt *> entryt;
+}
+
+static json_numbert seconds(std::chrono::steady_clock::duration time)
+{
+  return json_numbert(
+    std::to_string(std::chrono::duration<double>(time).count()));
+}
+
+static void output_cost(const costt &cost, json_objectt &dest)
+{
+  dest["steps"]=json_numbert(std::to_string(cost.steps));
+  dest["variables"]=json_numbert(std::to_string(cost.variables));
+  dest["clauses"]=json_numbert(std::to_string(cost.clauses));
+  dest["time"]=seconds(cost.time);
+}
+
+/// Appends the entries of `costs` to `dest`, most clauses first, and
+/// variables and then the order of `costs` to break ties
+template<class mapt>
+static void output_costs(
+  const mapt &costs,
+  const std::map<typename mapt::key_type, json_objectt> &descriptions,
+  json_arrayt &dest)
+{
+  std::vector<entryt> entries;
+  entries.reserve(costs.size());
+
+  for(const auto &c : costs)
+    entries.push_back(
+      entryt(&descriptions.find(c.first)->second, &c.second));
+
+  std::stable_sort(
+    entries.begin(),
+    entries.end(),
+    [](const entryt &a, const entryt &b)
+    {
+      if(a.second->clauses!=b.second->clauses)
+        return a.second->clauses>b.second->clauses;
+      return a.second->variables>b.second->variables;
+    });
+
+  for(const auto &entry : entries)
+  {
+    json_objectt &json_entry=dest.push_back(*entry.first).make_object();
+    output_cost(*entry.second, json_entry);
+  }
+}
+
+static loopst get_loops(const goto_functionst &goto_functions)
+{
+  loopst loops;
+
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      if(i_it->is_backwards_goto())
+      {
+        loopt loop;
+        loop.begin=i_it->get_target()->location_number;
+        loop.end=i_it->location_number;
+        loop.id=goto_programt::loop_id(*i_it);
+        loops[f_it->first].push_back(loop);
+      }
+
+  return loops;
+}
+
+/// \return the innermost loop in `loops` that contains `instruction`, or
+///   nullptr
+static const loopt *innermost_loop(
+  const loopst &loops,
+  const goto_programt::instructiont &instruction)
+{
+  loopst::const_iterator f_it=loops.find(instruction.function);
+  if(f_it==loops.end())
+    return nullptr;
+
+  const loopt *result=nullptr;
+
+  for(const auto &loop : f_it->second)
+    if(loop.begin<=instruction.location_number &&
+       instruction.location_number<=loop.end &&
+       (result==nullptr || loop.end-loop.begin<result->end-result->begin))
+      result=&loop;
+
+  return result;
+}
+
+json_objectt formula_cost_json(
+  const symex_target_equationt &equation,
+  const prop_convt &prop_conv,
+  const goto_functionst &goto_functions)
+{
+  const loopst loops=get_loops(goto_functions);
+
+  costt total;
+  std::map<std::string, costt> line_costs;
+  std::map<std::string, json_objectt> lines;
+  std::map<irep_idt, costt> function_costs;
+  std::map<irep_idt, json_objectt> functions;
+  std::map<irep_idt, costt> loop_costs;
+  std::map<irep_idt, json_objectt> loop_descriptions;
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    symex_target_equationt::conversion_costst::const_iterator cost=
+      equation.get_conversion_costs().find(&step);
+    if(cost==equation.get_conversion_costs().end())
+      continue;
+
+    const goto_programt::instructiont &instruction=*step.source.pc;
+    const source_locationt &source_location=instruction.source_location;
+
+    total.add(cost->second);
+
+    const std::string line=
+      id2string(source_location.get_file())+":"+
+      id2string(source_location.get_line());
+    line_costs[line].add(cost->second);
+
+    if(lines.find(line)==lines.end())
+    {
+      source_locationt line_location;
+      line_location.set_file(source_location.get_file());
+      line_location.set_line(source_location.get_line());
+      line_location.set_function(instruction.function);
+      lines[line]["sourceLocation"]=json(line_location);
+    }
+
+    function_costs[instruction.function].add(cost->second);
+    functions[instruction.function]["function"]=
+      json_stringt(id2string(instruction.function));
+
+    const loopt *loop=innermost_loop(loops, instruction);
+    if(loop!=nullptr)
+    {
+      loop_costs[loop->id].add(cost->second);
+      loop_descriptions[loop->id]["loop"]=json_stringt(id2string(loop->id));
+    }
+  }
+
+  json_objectt result;
+
+  result["variables"]=
+    json_numbert(std::to_string(prop_conv.get_number_of_variables()));
+  result["clauses"]=
+    json_numbert(std::to_string(prop_conv.get_number_of_clauses()));
+
+  json_objectt &attributed=result["attributed"].make_object();
+  output_cost(total, attributed);
+
+  output_costs(line_costs, lines, result["sourceLines"].make_array());
+  output_costs(function_costs, functions, result["functions"].make_array());
+  output_costs(loop_costs, loop_descriptions, result["loops"].make_array());
+
+  return result;
+}
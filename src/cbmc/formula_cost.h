@@ -0,0 +1,37 @@
+/*******************************************************************\
+
+Module: Attribution of the Formula Size to the Program
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Attribution of the Formula Size to the Program
+///
+/// The variables and clauses that the decision procedure creates while
+/// an SSA step is converted, and the time taken, are attributed to the
+/// instruction that produced the step. The costs are then summed up per
+/// source line, per function and per innermost loop.
+
+#ifndef CPROVER_CBMC_FORMULA_COST_H
+#define CPROVER_CBMC_FORMULA_COST_H
+
+#include <util/json.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <goto-symex/symex_target_equation.h>
+
+class prop_convt;
+
+/// \return the costs recorded by `equation` (see
+///   symex_target_equationt::enable_cost_accounting) in JSON, together
+///   with the total size of the formula in `prop_conv`. Each list is
+///   sorted by the number of clauses, largest first.
+json_objectt formula_cost_json(
+  const symex_target_equationt &equation,
+  const prop_convt &prop_conv,
+  const goto_functionst &goto_functions);
+
+#endif // CPROVER_CBMC_FORMULA_COST_H
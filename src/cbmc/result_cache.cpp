@@ -0,0 +1,297 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Verification Results
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Verification Results
+
+#include "result_cache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <util/symbol_table.h>
+
+#include <goto-programs/cfg.h>
+
+#include "version.h"
+
+// FNV-1a: unlike irept::hash(), which hashes string-table indices, this only
+// depends on the contents of the strings and thus is stable across runs.
+static const result_cachet::keyt fnv_offset=14695981039346656037ULL;
+static const result_cachet::keyt fnv_prime=1099511628211ULL;
+
+static result_cachet::keyt hash_string(
+  result_cachet::keyt h,
+  const std::string &s)
+{
+  for(const char c : s)
+  {
+    h^=static_cast<unsigned char>(c);
+    h*=fnv_prime;
+  }
+
+  // terminator, such that "a","bc" and "ab","c" differ
+  h^=0xff;
+  h*=fnv_prime;
+  return h;
+}
+
+static result_cachet::keyt hash_word(
+  result_cachet::keyt h,
+  result_cachet::keyt word)
+{
+  for(unsigned i=0; i<8; i++)
+  {
+    h^=(word>>(8*i))&0xff;
+    h*=fnv_prime;
+  }
+
+  return h;
+}
+
+static result_cachet::keyt hash_irep(const irept &irep)
+{
+  result_cachet::keyt h=hash_string(fnv_offset, irep.id_string());
+
+  // Named sub-trees are ordered by string-table index, which differs
+  // between runs, so they are combined commutatively. Comments (such as
+  // source locations) are not part of the hash.
+  result_cachet::keyt named=0;
+  forall_named_irep(it, irep.get_named_sub())
+    named+=hash_word(
+      hash_string(fnv_offset, id2string(it->first)),
+      hash_irep(it->second));
+  h=hash_word(h, named);
+
+  forall_irep(it, irep.get_sub())
+    h=hash_word(h, hash_irep(*it));
+
+  return h;
+}
+
+void result_cachet::read()
+{
+  std::ifstream in(file_name);
+  if(!in)
+    return;
+
+  std::string line;
+  while(std::getline(in, line))
+  {
+    std::istringstream line_stream(line);
+    keyt key;
+    std::string status;
+    if(line_stream >> std::hex >> key >> status &&
+       (status=="SUCCESS" || status=="FAILURE"))
+      results[key]=status;
+  }
+}
+
+void result_cachet::write()
+{
+  if(!modified)
+    return;
+
+  std::ofstream out(file_name);
+  if(!out)
+  {
+    warning() << "failed to write result cache `" << file_name << "'"
+              << eom;
+    return;
+  }
+
+  for(const auto &entry : results)
+    out << std::hex << std::setw(16) << std::setfill('0') << entry.first
+        << ' ' << entry.second << '\n';
+
+  modified=false;
+}
+
+/// Hash of everything outside the program instructions that results depend
+/// on: the tool version, the options and the type definitions.
+result_cachet::keyt result_cachet::context_hash() const
+{
+  keyt h=hash_string(fnv_offset, CBMC_VERSION);
+
+  optionst::option_mapt option_map=options.get_option_map();
+  option_map.erase("result-cache");
+  option_map.erase("trace");
+
+  for(const auto &option : option_map)
+  {
+    h=hash_string(h, option.first);
+    for(const auto &value : option.second)
+      h=hash_string(h, value);
+  }
+
+  keyt types=0;
+  forall_symbols(it, ns.get_symbol_table().symbols)
+    if(it->second.is_type)
+      types+=hash_word(
+        hash_string(fnv_offset, id2string(it->first)),
+        hash_irep(it->second.type));
+
+  return hash_word(h, types);
+}
+
+void result_cachet::operator()(const goto_functionst &goto_functions)
+{
+  read();
+
+  const keyt context=context_hash();
+
+  typedef cfg_baset<empty_cfg_nodet> cfgt;
+  cfgt cfg;
+  cfg(goto_functions);
+
+  // Functions in name order, such that the position of an instruction in
+  // this order (its rank) can be used to enumerate a cone canonically.
+  std::vector<goto_functionst::function_mapt::const_iterator> functions;
+  forall_goto_functions(f_it, goto_functions)
+    if(f_it->second.body_available())
+      functions.push_back(f_it);
+  std::sort(
+    functions.begin(),
+    functions.end(),
+    [](
+      const goto_functionst::function_mapt::const_iterator &a,
+      const goto_functionst::function_mapt::const_iterator &b)
+    {
+      return id2string(a->first)<id2string(b->first);
+    });
+
+  // per CFG node: rank and hash of the instruction
+  std::vector<std::size_t> rank(cfg.size(), 0);
+  std::vector<keyt> instruction_hash(cfg.size(), 0);
+  std::vector<std::pair<cfgt::entryt, goto_programt::const_targett>>
+    assertions;
+  bool threaded=false;
+
+  std::size_t next_rank=0;
+  for(const auto &f_it : functions)
+  {
+    const goto_programt &body=f_it->second.body;
+    const keyt function_hash=
+      hash_string(fnv_offset, id2string(f_it->first));
+
+    std::map<goto_programt::const_targett, std::size_t> index;
+    std::size_t i=0;
+    forall_goto_program_instructions(i_it, body)
+      index[i_it]=i++;
+
+    forall_goto_program_instructions(i_it, body)
+    {
+      const cfgt::entryt node=cfg.entry_map[i_it];
+
+      keyt h=hash_word(function_hash, index[i_it]);
+      h=hash_word(h, static_cast<keyt>(i_it->type));
+      h=hash_word(h, hash_irep(i_it->code));
+      h=hash_word(h, hash_irep(i_it->guard));
+      for(const auto &target : i_it->targets)
+        h=hash_word(h, index[target]);
+
+      rank[node]=next_rank++;
+      instruction_hash[node]=h;
+
+      if(i_it->is_assert())
+        assertions.push_back(std::make_pair(node, i_it));
+      else if(i_it->is_start_thread())
+        threaded=true;
+    }
+  }
+
+  std::vector<keyt> hash_by_rank(cfg.size());
+  for(std::size_t node=0; node<cfg.size(); node++)
+    hash_by_rank[rank[node]]=instruction_hash[node];
+
+  // Everything that can influence an assertion precedes it on some path.
+  // With threads, interleavings are not captured by the CFG, so the cone
+  // is the whole program.
+  for(const auto &assertion : assertions)
+  {
+    std::vector<std::size_t> cone;
+
+    if(threaded)
+    {
+      cone=rank;
+    }
+    else
+    {
+      std::vector<bool> visited(cfg.size(), false);
+      std::vector<cfgt::entryt> stack(1, assertion.first);
+      visited[assertion.first]=true;
+
+      while(!stack.empty())
+      {
+        const cfgt::entryt node=stack.back();
+        stack.pop_back();
+        cone.push_back(rank[node]);
+
+        for(const auto &in : cfg[node].in)
+        {
+          if(!visited[in.first])
+          {
+            visited[in.first]=true;
+            stack.push_back(in.first);
+          }
+        }
+      }
+    }
+
+    std::sort(cone.begin(), cone.end());
+
+    keyt key=hash_word(context, instruction_hash[assertion.first]);
+    for(const auto r : cone)
+      key=hash_word(key, hash_by_rank[r]);
+
+    keys[assertion.second->source_location.get_property_id()]=key;
+  }
+}
+
+bool result_cachet::has_result(
+  const irep_idt &property,
+  std::string &status) const
+{
+  const auto key_it=keys.find(property);
+  if(key_it==keys.end())
+    return false;
+
+  const auto result_it=results.find(key_it->second);
+  if(result_it==results.end())
+    return false;
+
+  status=result_it->second;
+  return true;
+}
+
+bool result_cachet::complete(bool with_failures) const
+{
+  for(const auto &key : keys)
+  {
+    const auto result_it=results.find(key.second);
+    if(result_it==results.end() ||
+       (!with_failures && result_it->second=="FAILURE"))
+      return false;
+  }
+
+  return true;
+}
+
+void result_cachet::store(
+  const irep_idt &property,
+  const std::string &status)
+{
+  const auto key_it=keys.find(property);
+  if(key_it==keys.end())
+    return;
+
+  results[key_it->second]=status;
+  modified=true;
+}
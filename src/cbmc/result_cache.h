@@ -0,0 +1,84 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Verification Results
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Verification Results
+///
+/// Each property is identified by a hash over the instructions that can
+/// reach it (its backward cone in the interprocedural control-flow graph,
+/// which includes everything that can influence its outcome), all type
+/// definitions and the options. The hashes do not depend on source
+/// locations, so results remain valid across unrelated edits. They are
+/// stable across runs of the same tool version.
+
+#ifndef CPROVER_CBMC_RESULT_CACHE_H
+#define CPROVER_CBMC_RESULT_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/options.h>
+
+#include <goto-programs/goto_functions.h>
+
+class result_cachet:public messaget
+{
+public:
+  result_cachet(
+    const std::string &_file_name,
+    const optionst &_options,
+    const namespacet &_ns,
+    message_handlert &_message_handler):
+    messaget(_message_handler),
+    file_name(_file_name),
+    options(_options),
+    ns(_ns),
+    modified(false)
+  {
+  }
+
+  /// Reads the cache file (a missing file is an empty cache) and computes
+  /// the keys of all assertions in `goto_functions`.
+  void operator()(const goto_functionst &goto_functions);
+
+  typedef std::uint64_t keyt;
+
+  /// \return true if `property` has a cached result, which is then stored
+  ///   in `status` ("SUCCESS" or "FAILURE")
+  bool has_result(const irep_idt &property, std::string &status) const;
+
+  /// \param with_failures: whether FAILURE results are usable
+  /// \return true if every assertion has a usable cached result
+  bool complete(bool with_failures) const;
+
+  /// Records the result of a property that was checked in this run.
+  void store(const irep_idt &property, const std::string &status);
+
+  /// Writes the cache file, if anything was stored.
+  void write();
+
+protected:
+  const std::string file_name;
+  const optionst &options;
+  const namespacet &ns;
+  bool modified;
+
+  // property ID -> key
+  std::map<irep_idt, keyt> keys;
+  // key -> status
+  std::map<keyt, std::string> results;
+
+  void read();
+
+  keyt context_hash() const;
+};
+
+#endif // CPROVER_CBMC_RESULT_CACHE_H
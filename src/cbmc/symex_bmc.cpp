@@ -24,6 +24,10 @@ symex_bmct::symex_bmct(
   record_coverage(false),
   max_unwind(0),
   max_unwind_is_set(false),
+  incremental_all_loops(false),
+  incremental_bound(0),
+  incremental_bound_is_set(false),
+  incremental_last_round(false),
   symex_coverage(_ns)
 {
 }
@@ -130,6 +134,14 @@ bool symex_bmct::get_unwind(
       this_loop_limit=max_unwind;
   }
 
+  // the bound of a loop that is deepened incrementally overrides
+  // the global limit, and explicit limits if the loop was named
+  if(is_incremental_loop(id) &&
+     (incremental_loops.count(id)!=0 ||
+      (this_thread_limits.find(id)==this_thread_limits.end() &&
+       loop_limits.find(id)==loop_limits.end())))
+    this_loop_limit=incremental_bound;
+
   bool abort=unwind>=this_loop_limit;
 
   statistics() << (abort?"Not unwinding":"Unwinding")
@@ -145,6 +157,135 @@ bool symex_bmct::get_unwind(
   return abort;
 }
 
+/// Pauses a path of a loop that is deepened incrementally: a copy of the
+/// state that takes the backwards jump is kept for the next round, and
+/// this state leaves the loop after an unwinding assertion. The
+/// assertion fails iff the path can reach another iteration.
+void symex_bmct::loop_bound_exceeded(
+  statet &state,
+  const exprt &guard)
+{
+  const irep_idt id=goto_programt::loop_id(*state.source.pc);
+
+  if(incremental_last_round || !is_incremental_loop(id))
+  {
+    goto_symext::loop_bound_exceeded(state, guard);
+    return;
+  }
+
+  paused_states.push_back(state);
+  statet &paused_state=paused_states.back();
+
+  // pending merges belong to the path that goes on in this round, and
+  // the calls return on that path only
+  for(auto &thread : paused_state.threads)
+    for(auto &frame : thread.call_stack)
+    {
+      frame.goto_state_map.clear();
+      frame.summary_key.make_nil();
+    }
+
+  paused_state.guard.add(guard);
+  symex_transition(paused_state, state.source.pc->get_target(), true);
+
+  exprt negated_cond;
+
+  if(guard.is_true())
+    negated_cond=false_exprt();
+  else
+    negated_cond=not_exprt(guard);
+
+  vcc(negated_cond,
+      "unwinding assertion loop "+
+        std::to_string(state.source.pc->loop_number),
+      state);
+
+  state.guard.add(negated_cond);
+}
+
+/// Makes the L1 and L2 names that \p state will introduce distinct from
+/// those used since \p state was paused. \p l2_counts holds the highest
+/// L2 index of each variable used so far, and \p previous_state is the
+/// state of the path that was executed last. Variables whose L2 index in
+/// \p state is lower are copied into a fresh L2 name.
+void symex_bmct::rename_apart(
+  statet &state,
+  const statet &previous_state,
+  const statet::level2t::current_namest &l2_counts)
+{
+  state.l1_history.insert(
+    previous_state.l1_history.begin(),
+    previous_state.l1_history.end());
+
+  for(const auto &name : l2_counts)
+  {
+    const irep_idt &l1_identifier=name.first;
+    const unsigned max_count=name.second.second;
+
+    statet::level2t::current_namest::iterator c_it=
+      state.level2.current_names.find(l1_identifier);
+
+    const unsigned count=
+      c_it==state.level2.current_names.end()?0:c_it->second.second;
+
+    if(count>=max_count)
+      continue;
+
+    const ssa_exprt &l1_expr=name.second.first;
+
+    // guards are only referred to by their L2 names
+    if(l1_expr.get_object_name()==guard_identifier)
+    {
+      state.level2.current_names[l1_identifier]=name.second;
+      continue;
+    }
+
+    exprt rhs=l1_expr;
+
+    statet::propagationt::valuest::const_iterator p_it=
+      state.propagation.values.find(l1_identifier);
+
+    if(p_it!=state.propagation.values.end())
+      rhs=p_it->second;
+    else
+      to_ssa_expr(rhs).set_level_2(count);
+
+    if(c_it==state.level2.current_names.end())
+      state.level2.current_names[l1_identifier]=name.second;
+    else
+      c_it->second.second=max_count;
+
+    ssa_exprt new_lhs=l1_expr;
+    const bool record_events=state.record_events;
+    state.record_events=false;
+    state.assignment(new_lhs, rhs, ns, true, true);
+    state.record_events=record_events;
+
+    target.assignment(
+      true_exprt(),
+      new_lhs, new_lhs, new_lhs.get_original_expr(),
+      rhs,
+      state.source,
+      symex_targett::assignment_typet::PHI);
+  }
+}
+
+/// Continues symbolic execution of a paused state until the end of the
+/// program, see rename_apart for the arguments.
+void symex_bmct::resume(
+  statet &state,
+  const statet &previous_state,
+  const statet::level2t::current_namest &l2_counts,
+  const goto_functionst &goto_functions)
+{
+  assert(state.threads.size()==1);
+
+  rename_apart(state, previous_state, l2_counts);
+
+  while(!state.call_stack().empty())
+    symex_step(goto_functions, state);
+}
+
 bool symex_bmct::get_unwind_recursion(
   const irep_idt &id,
   const unsigned thread_nr,
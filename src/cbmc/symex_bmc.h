@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_SYMEX_BMC_H
 #define CPROVER_CBMC_SYMEX_BMC_H
 
+#include <list>
+
 #include <util/message.h>
 
 #include <goto-symex/goto_symex.h>
@@ -63,6 +65,40 @@ public:
 
   bool record_coverage;
 
+  // Incremental loop deepening: loops that reach the current bound are
+  // paused rather than cut off, and resumed one iteration deeper in the
+  // next round.
+
+  void set_incremental_loop(const irep_idt &id)
+  {
+    incremental_loops.insert(id);
+  }
+
+  void set_incremental_all_loops()
+  {
+    incremental_all_loops=true;
+  }
+
+  // In the last round, loops exceeding the bound are treated as usual,
+  // i.e., by unwinding assertions or assumptions.
+  void set_incremental_bound(unsigned bound, bool last_round)
+  {
+    incremental_bound=bound;
+    incremental_bound_is_set=true;
+    incremental_last_round=last_round;
+  }
+
+  // States of the paths paused at a loop bound, each about to
+  // take the backwards jump into another iteration
+  typedef std::list<statet> paused_statest;
+  paused_statest paused_states;
+
+  void resume(
+    statet &state,
+    const statet &previous_state,
+    const statet::level2t::current_namest &l2_counts,
+    const goto_functionst &goto_functions);
+
 protected:
   // We have
   // 1) a global limit (max_unwind)
@@ -79,6 +115,23 @@ protected:
   typedef std::map<unsigned, loop_limitst> thread_loop_limitst;
   thread_loop_limitst thread_loop_limits;
 
+  std::unordered_set<irep_idt, irep_id_hash> incremental_loops;
+  bool incremental_all_loops;
+  unsigned incremental_bound;
+  bool incremental_bound_is_set;
+  bool incremental_last_round;
+
+  bool is_incremental_loop(const irep_idt &id) const
+  {
+    return incremental_bound_is_set &&
+           (incremental_all_loops || incremental_loops.count(id)!=0);
+  }
+
+  void rename_apart(
+    statet &state,
+    const statet &previous_state,
+    const statet::level2t::current_namest &l2_counts);
+
   //
   // overloaded from goto_symext
   //
@@ -95,6 +148,8 @@ protected:
     const symex_targett::sourcet &source,
     unsigned unwind);
 
+  virtual void loop_bound_exceeded(statet &state, const exprt &guard);
+
   virtual bool get_unwind_recursion(
     const irep_idt &identifier,
     const unsigned thread_nr,
@@ -228,6 +228,22 @@ const symbolt &cpp_typecheckt::instantiate_template(
     throw 0;
   }
 
+  // have we completed this instance already?
+  const std::string cache_key=
+    id2string(template_symbol.name)+template_suffix(full_template_args);
+
+  instantiation_cachet::const_iterator cache_it=
+    instantiation_cache.find(cache_key);
+
+  // entries are only added once the instance is complete
+  if(cache_it!=instantiation_cache.end())
+  {
+    instantiation_cache_hits++;
+    return lookup(cache_it->second);
+  }
+
+  nested_timert timer(instantiation_time, instantiation_depth);
+
   instantiation_levelt i_level(instantiation_stack);
   instantiation_stack.back().source_location=source_location;
   instantiation_stack.back().identifier=template_symbol.name;
@@ -272,7 +288,8 @@ const symbolt &cpp_typecheckt::instantiate_template(
   }
 
   // produce new symbol name
-  std::string suffix=template_suffix(full_template_args);
+  const std::string suffix=
+    cache_key.substr(id2string(template_symbol.name).size());
 
   // we need the template scope to see the template parameters
   cpp_scopet *template_scope=
@@ -345,11 +362,13 @@ const symbolt &cpp_typecheckt::instantiate_template(
       const symbolt &symb=lookup(cpp_id.identifier);
 
       // continue if the type is incomplete only
-      if(cpp_id.id_class==cpp_idt::id_classt::CLASS &&
-         symb.type.id()==ID_struct)
-        return symb;
-      else if(symb.value.is_not_nil())
+      if((cpp_id.id_class==cpp_idt::id_classt::CLASS &&
+          symb.type.id()==ID_struct) ||
+         symb.value.is_not_nil())
+      {
+        instantiation_cache[cache_key]=symb.name;
         return symb;
+      }
     }
 
     cpp_scopes.go_to(scope);
@@ -446,6 +465,11 @@ const symbolt &cpp_typecheckt::instantiate_template(
     const symbolt &new_symb=
       lookup(new_decl.type().get(ID_identifier));
 
+    // the next lookup of a complete instance need not go through the
+    // scopes
+    if(new_symb.type.id()==ID_struct)
+      instantiation_cache[cache_key]=new_symb.name;
+
     return new_symb;
   }
 
@@ -497,7 +521,13 @@ const symbolt &cpp_typecheckt::instantiate_template(
       false,
       false);
 
-    return lookup(to_struct_type(symb.type).components().back().get(ID_name));
+    const symbolt &new_symb=
+      lookup(to_struct_type(symb.type).components().back().get(ID_name));
+
+    if(new_symb.value.is_not_nil())
+      instantiation_cache[cache_key]=new_symb.name;
+
+    return new_symb;
   }
 
   // not a class template, not a class template method,
@@ -510,5 +540,8 @@ const symbolt &cpp_typecheckt::instantiate_template(
   const symbolt &symb=
     lookup(new_decl.declarators()[0].get(ID_identifier));
 
+  if(symb.value.is_not_nil())
+    instantiation_cache[cache_key]=symb.name;
+
   return symb;
 }
@@ -50,14 +50,33 @@ void cpp_typecheckt::typecheck()
   // default linkage is "automatic"
   current_linkage_spec=ID_auto;
 
+  absolute_timet start=current_time();
+
   for(auto &item : cpp_parse_tree.items)
     convert(item);
 
+  absolute_timet declarations_done=current_time();
+
   static_and_dynamic_initialization();
 
+  absolute_timet initialization_done=current_time();
+
   do_not_typechecked();
 
+  absolute_timet bodies_done=current_time();
+
   clean_up();
+
+  statistics() << "C++ type checking: declarations "
+               << (declarations_done-start) << "s, initialization "
+               << (initialization_done-declarations_done)
+               << "s, remaining function bodies "
+               << (bodies_done-initialization_done) << "s, clean-up "
+               << (current_time()-bodies_done) << "s; in total "
+               << resolve_time << "s in name resolution and "
+               << instantiation_time << "s in template instantiation, "
+               << instantiation_cache.size() << " instances, "
+               << instantiation_cache_hits << " cache hits" << eom;
 }
 
 const struct_typet &cpp_typecheckt::this_struct_type()
@@ -16,9 +16,11 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #include <set>
 #include <list>
 #include <map>
+#include <unordered_map>
 
 #include <util/std_code.h>
 #include <util/std_types.h>
+#include <util/time_stopping.h>
 
 #include <ansi-c/c_typecheck_base.h>
 
@@ -53,7 +55,10 @@ public:
     cpp_parse_tree(_cpp_parse_tree),
     template_counter(0),
     anon_counter(0),
-    disable_access_control(false)
+    disable_access_control(false),
+    resolve_depth(0),
+    instantiation_depth(0),
+    instantiation_cache_hits(0)
   {
   }
 
@@ -68,7 +73,10 @@ public:
     cpp_parse_tree(_cpp_parse_tree),
     template_counter(0),
     anon_counter(0),
-    disable_access_control(false)
+    disable_access_control(false),
+    resolve_depth(0),
+    instantiation_depth(0),
+    instantiation_cache_hits(0)
   {
   }
 
@@ -90,6 +98,7 @@ public:
     const cpp_typecheck_fargst &fargs,
     bool fail_with_exception=true)
   {
+    nested_timert timer(resolve_time, resolve_depth);
     cpp_typecheck_resolvet cpp_typecheck_resolve(*this);
     return cpp_typecheck_resolve.resolve(
       cpp_name, want, fargs, fail_with_exception);
@@ -105,6 +114,30 @@ public:
     const exprt::operandst &operands);
 
 protected:
+  /// Accumulates the time spent in the outermost of a set of nested
+  /// (possibly recursive) calls
+  class nested_timert
+  {
+  public:
+    nested_timert(time_periodt &_total, unsigned &_depth):
+      total(_total), depth(_depth)
+    {
+      if(depth++==0)
+        start=current_time();
+    }
+
+    ~nested_timert()
+    {
+      if(--depth==0)
+        total+=current_time()-start;
+    }
+
+  protected:
+    time_periodt &total;
+    unsigned &depth;
+    absolute_timet start;
+  };
+
   cpp_scopest cpp_scopes;
 
   cpp_parse_treet &cpp_parse_tree;
@@ -182,6 +215,12 @@ protected:
   typedef std::list<instantiationt> instantiation_stackt;
   instantiation_stackt instantiation_stack;
 
+  // Completed instantiations, indexed by the template symbol followed
+  // by the suffix generated from the template arguments. This saves
+  // re-building the declaration before the existing instance is found.
+  typedef std::unordered_map<std::string, irep_idt> instantiation_cachet;
+  instantiation_cachet instantiation_cache;
+
   void show_instantiation_stack(std::ostream &);
 
   class instantiation_levelt
@@ -594,6 +633,11 @@ private:
   typedef std::list<irep_idt> dynamic_initializationst;
   dynamic_initializationst dynamic_initializations;
   bool disable_access_control;           // Disable protect and private
+
+  // statistics about the phases of type checking
+  time_periodt resolve_time, instantiation_time;
+  unsigned resolve_depth, instantiation_depth;
+  std::size_t instantiation_cache_hits;
 };
 
 #endif // CPROVER_CPP_CPP_TYPECHECK_H
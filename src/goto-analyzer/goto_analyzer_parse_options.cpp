@@ -306,7 +306,7 @@ int goto_analyzer_parse_optionst::doit()
 
   if(cmdline.isset("show-intervals"))
   {
-    show_intervals(goto_model, std::cout);
+    show_intervals(goto_model, cmdline.isset("sparse-states"), std::cout);
     return 0;
   }
 
@@ -316,6 +316,7 @@ int goto_analyzer_parse_optionst::doit()
     optionst options;
     options.set_option("json", cmdline.get_value("json"));
     options.set_option("xml", cmdline.get_value("xml"));
+    options.set_option("sparse-states", cmdline.isset("sparse-states"));
     bool result=
       static_analyzer(goto_model, options, get_message_handler());
     return result?10:0;
@@ -478,6 +479,8 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --json file_name             output results in JSON format to given file\n"
     " --xml file_name              output results in XML format to given file\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --sparse-states              keep abstract states only at branches and joins\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -45,7 +45,7 @@ class optionst;
   "(json):(xml):" \
   "(unreachable-instructions)(unreachable-functions)" \
   "(reachable-functions)" \
-  "(intervals)(show-intervals)" \
+  "(intervals)(show-intervals)(sparse-states)" \
   "(non-null)(show-non-null)" \
   JAVA_BYTECODE_LANGUAGE_OPTIONS
 
@@ -16,6 +16,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <analyses/interval_domain.h>
 
+// number of recomputed states kept with sparse state storage
+static const std::size_t sparse_state_cache_size=64;
+
 class static_analyzert:public messaget
 {
 public:
@@ -38,7 +41,7 @@ protected:
   const optionst &options;
 
   // analyses
-  ait<interval_domaint> interval_analysis;
+  widening_ait<interval_domaint> interval_analysis;
 
   void plain_text_report();
   void json_report(const std::string &);
@@ -49,8 +52,14 @@ protected:
 
 bool static_analyzert::operator()()
 {
+  if(options.get_bool_option("sparse-states"))
+    interval_analysis.set_sparse_storage(sparse_state_cache_size);
+
   status() << "performing interval analysis" << eom;
   interval_analysis(goto_functions, ns);
+  statistics() << "interval analysis visited "
+               << interval_analysis.get_number_of_visits()
+               << " instructions" << eom;
 
   if(!options.get_option("json").empty())
     json_report(options.get_option("json"));
@@ -228,9 +237,12 @@ bool static_analyzer(
 
 void show_intervals(
   const goto_modelt &goto_model,
+  bool sparse_states,
   std::ostream &out)
 {
-  ait<interval_domaint> interval_analysis;
+  widening_ait<interval_domaint> interval_analysis;
+  if(sparse_states)
+    interval_analysis.set_sparse_storage(sparse_state_cache_size);
   interval_analysis(goto_model);
   interval_analysis.output(goto_model, out);
 }
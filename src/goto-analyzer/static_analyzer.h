@@ -25,6 +25,7 @@ bool static_analyzer(
 
 void show_intervals(
   const goto_modelt &,
+  bool sparse_states,
   std::ostream &);
 
 #endif // CPROVER_GOTO_ANALYZER_STATIC_ANALYZER_H
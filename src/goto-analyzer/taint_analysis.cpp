@@ -11,8 +11,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "taint_analysis.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 
 #include <util/prefix.h>
 #include <util/simplify_expr.h>
@@ -44,10 +47,88 @@ protected:
   taint_parse_treet taint;
   class_hierarchyt class_hierarchy;
 
+  // a rule together with the taint operand of its instrumentation, which
+  // is built once and then shared by all call sites
+  struct compiled_rulet
+  {
+    const taint_parse_treet::rulet *rule;
+    exprt taint;
+  };
+
+  std::vector<compiled_rulet> compiled_rules;
+
+  // the numbers of the rules that apply to a function, by its identifier
+  // or, for Java, by the prefix up to the signature
+  typedef std::vector<std::size_t> rule_numberst;
+  typedef std::unordered_map<irep_idt, rule_numberst, irep_id_hash>
+    rule_indext;
+  rule_indext rule_index;
+
+  // rules whose function identifier contains a colon, which are matched
+  // against every call
+  rule_numberst unindexed_rules;
+
+  void compile_rules();
+  void matching_rules(const irep_idt &identifier, rule_numberst &dest) const;
+
   void instrument(const namespacet &, goto_functionst &);
   void instrument(const namespacet &, goto_functionst::goto_functiont &);
 };
 
+void taint_analysist::compile_rules()
+{
+  for(const auto &rule : taint.rules)
+  {
+    const std::size_t rule_number=compiled_rules.size();
+    compiled_rules.push_back(
+      compiled_rulet{&rule, address_of_exprt(string_constantt(rule.taint))});
+
+    const std::string &function_identifier=
+      id2string(rule.function_identifier);
+
+    if(function_identifier.find(':')==std::string::npos)
+      rule_index[rule.function_identifier].push_back(rule_number);
+    else
+      unindexed_rules.push_back(rule_number);
+  }
+}
+
+/// Adds the numbers of the rules for function `identifier` to `dest`. A
+/// rule applies if its function identifier is `identifier` or, for a Java
+/// method, `identifier` without the `java::` prefix and the signature.
+void taint_analysist::matching_rules(
+  const irep_idt &identifier,
+  rule_numberst &dest) const
+{
+  rule_indext::const_iterator entry=rule_index.find(identifier);
+  if(entry!=rule_index.end())
+    dest.insert(dest.end(), entry->second.begin(), entry->second.end());
+
+  const std::string &id=id2string(identifier);
+
+  if(has_prefix(id, "java::"))
+  {
+    const std::size_t colon=id.find(':', 6);
+
+    if(colon!=std::string::npos)
+    {
+      entry=rule_index.find(id.substr(6, colon-6));
+      if(entry!=rule_index.end())
+        dest.insert(dest.end(), entry->second.begin(), entry->second.end());
+    }
+  }
+
+  for(const auto &rule_number : unindexed_rules)
+  {
+    const irep_idt &function_identifier=
+      compiled_rules[rule_number].rule->function_identifier;
+
+    if(identifier==function_identifier ||
+       has_prefix(id, "java::"+id2string(function_identifier)+":"))
+      dest.push_back(rule_number);
+  }
+}
+
 void taint_analysist::instrument(
   const namespacet &ns,
   goto_functionst &goto_functions)
@@ -102,101 +183,99 @@ void taint_analysist::instrument(
               identifiers.insert(id2string(p)+suffix);
           }
 
-          for(const auto &rule : taint.rules)
+          rule_numberst rule_numbers;
+          for(const auto &i : identifiers)
+            matching_rules(i, rule_numbers);
+
+          // apply each rule once, in the order of the taint file
+          std::sort(rule_numbers.begin(), rule_numbers.end());
+          rule_numbers.erase(
+            std::unique(rule_numbers.begin(), rule_numbers.end()),
+            rule_numbers.end());
+
+          for(const auto &rule_number : rule_numbers)
           {
-            bool match=false;
-            for(const auto &i : identifiers)
-              if(i==rule.function_identifier ||
-                 has_prefix(
-                   id2string(i),
-                   "java::"+id2string(rule.function_identifier)+":"))
-              {
-                match=true;
-                break;
-              }
+            const taint_parse_treet::rulet &rule=
+              *compiled_rules[rule_number].rule;
+            const exprt &taint_expr=compiled_rules[rule_number].taint;
+
+            debug() << "MATCH " << rule.id << " on " << identifier << eom;
+
+            exprt where=nil_exprt();
+
+            const code_typet &code_type=to_code_type(function.type());
+
+            bool have_this=
+              !code_type.parameters().empty() &&
+              code_type.parameters().front().get_bool(ID_C_this);
 
-            if(match)
+            switch(rule.where)
             {
-              debug() << "MATCH " << rule.id << " on " << identifier << eom;
+            case taint_parse_treet::rulet::RETURN_VALUE:
+              {
+                const symbolt &return_value_symbol=
+                  ns.lookup(id2string(identifier)+"#return_value");
+                where=return_value_symbol.symbol_expr();
+              }
+              break;
 
-              exprt where=nil_exprt();
+            case taint_parse_treet::rulet::PARAMETER:
+              {
+                unsigned nr=
+                  have_this?rule.parameter_number:rule.parameter_number-1;
+                if(function_call.arguments().size()>nr)
+                  where=function_call.arguments()[nr];
+              }
+              break;
 
-              const code_typet &code_type=to_code_type(function.type());
+            case taint_parse_treet::rulet::THIS:
+              if(have_this)
+              {
+                assert(!function_call.arguments().empty());
+                where=function_call.arguments()[0];
+              }
+              break;
+            }
 
-              bool have_this=
-                !code_type.parameters().empty() &&
-                code_type.parameters().front().get_bool(ID_C_this);
+            switch(rule.kind)
+            {
+            case taint_parse_treet::rulet::SOURCE:
+              {
+                codet code_set_may("set_may");
+                code_set_may.operands().resize(2);
+                code_set_may.op0()=where;
+                code_set_may.op1()=taint_expr;
+                goto_programt::targett t=insert_after.add_instruction();
+                t->make_other(code_set_may);
+                t->source_location=instruction.source_location;
+              }
+              break;
 
-              switch(rule.where)
+            case taint_parse_treet::rulet::SINK:
               {
-              case taint_parse_treet::rulet::RETURN_VALUE:
-                {
-                  const symbolt &return_value_symbol=
-                    ns.lookup(id2string(identifier)+"#return_value");
-                  where=return_value_symbol.symbol_expr();
-                }
-                break;
-
-              case taint_parse_treet::rulet::PARAMETER:
-                {
-                  unsigned nr=
-                    have_this?rule.parameter_number:rule.parameter_number-1;
-                  if(function_call.arguments().size()>nr)
-                    where=function_call.arguments()[nr];
-                }
-                break;
-
-              case taint_parse_treet::rulet::THIS:
-                if(have_this)
-                {
-                  assert(!function_call.arguments().empty());
-                  where=function_call.arguments()[0];
-                }
-                break;
+                goto_programt::targett t=insert_before.add_instruction();
+                binary_predicate_exprt get_may("get_may");
+                get_may.op0()=where;
+                get_may.op1()=taint_expr;
+                t->make_assertion(not_exprt(get_may));
+                t->source_location=instruction.source_location;
+                t->source_location.set_property_class(
+                  "taint rule "+id2string(rule.id));
+                t->source_location.set_comment(rule.message);
               }
+              break;
 
-              switch(rule.kind)
+            case taint_parse_treet::rulet::SANITIZER:
               {
-              case taint_parse_treet::rulet::SOURCE:
-                {
-                  codet code_set_may("set_may");
-                  code_set_may.operands().resize(2);
-                  code_set_may.op0()=where;
-                  code_set_may.op1()=
-                    address_of_exprt(string_constantt(rule.taint));
-                  goto_programt::targett t=insert_after.add_instruction();
-                  t->make_other(code_set_may);
-                  t->source_location=instruction.source_location;
-                }
-                break;
-
-              case taint_parse_treet::rulet::SINK:
-                {
-                  goto_programt::targett t=insert_before.add_instruction();
-                  binary_predicate_exprt get_may("get_may");
-                  get_may.op0()=where;
-                  get_may.op1()=address_of_exprt(string_constantt(rule.taint));
-                  t->make_assertion(not_exprt(get_may));
-                  t->source_location=instruction.source_location;
-                  t->source_location.set_property_class(
-                    "taint rule "+id2string(rule.id));
-                  t->source_location.set_comment(rule.message);
-                }
-                break;
-
-              case taint_parse_treet::rulet::SANITIZER:
-                {
-                  codet code_clear_may("clear_may");
-                  code_clear_may.operands().resize(2);
-                  code_clear_may.op0()=where;
-                  code_clear_may.op1()=
-                    address_of_exprt(string_constantt(rule.taint));
-                  goto_programt::targett t=insert_after.add_instruction();
-                  t->make_other(code_clear_may);
-                  t->source_location=instruction.source_location;
-                }
-                break;
+                codet code_clear_may("clear_may");
+                code_clear_may.operands().resize(2);
+                code_clear_may.op0()=where;
+                code_clear_may.op1()=taint_expr;
+                goto_programt::targett t=insert_after.add_instruction();
+                t->make_other(code_clear_may);
+                t->source_location=instruction.source_location;
               }
+              break;
             }
           }
         }
@@ -252,6 +331,8 @@ bool taint_analysist::operator()(
 
     status() << "Instrumenting taint" << eom;
 
+    compile_rules();
+
     class_hierarchy(symbol_table);
 
     const namespacet ns(symbol_table);
@@ -317,14 +317,26 @@ void change_impactt::change_impact(const irep_idt &function)
 {
   unified_difft::goto_program_difft diff = unified_diff.get_diff(function);
 
-  if(diff.empty())
-    return;
-
   goto_functionst::function_mapt::const_iterator old_fit=
     old_goto_functions.function_map.find(function);
   goto_functionst::function_mapt::const_iterator new_fit=
     new_goto_functions.function_map.find(function);
 
+  if(diff.empty())
+  {
+    // Functions that are equal are not diffed at all, but are
+    // still output (as unchanged unless dependencies reach into them).
+    if(unified_diff.differences_map().count(function)==0 &&
+       old_fit!=old_goto_functions.function_map.end() &&
+       old_fit->second.body_available())
+    {
+      old_change_impact[function];
+      new_change_impact[function];
+    }
+
+    return;
+  }
+
   goto_programt empty;
 
   const goto_programt &old_goto_program=
@@ -11,6 +11,8 @@ Author: Peter Schrammel
 
 #include "syntactic_diff.h"
 
+#include <goto-programs/goto_program_equal.h>
+
 bool syntactic_difft::operator()()
 {
   forall_goto_functions(it, goto_model1.goto_functions)
@@ -27,31 +29,8 @@ bool syntactic_difft::operator()()
       continue;
     }
 
-    if(it->second.body.instructions.size() !=
-       f_it->second.body.instructions.size())
-    {
+    if(!goto_program_equal(it->second.body, f_it->second.body))
       modified_functions.insert(it->first);
-      continue;
-    }
-
-    goto_programt::instructionst::const_iterator
-      i_it1=it->second.body.instructions.begin();
-    for(goto_programt::instructionst::const_iterator
-        i_it2=f_it->second.body.instructions.begin();
-        i_it1!=it->second.body.instructions.end() &&
-        i_it2!=f_it->second.body.instructions.end();
-        ++i_it1, ++i_it2)
-    {
-      if(i_it1->code != i_it2->code ||
-         i_it1->function != i_it2->function ||
-         i_it1->type != i_it2->type ||
-         i_it1->guard != i_it2->guard ||
-         i_it1->targets != i_it2->targets)
-      {
-        modified_functions.insert(it->first);
-        break;
-      }
-    }
   }
   forall_goto_functions(it, goto_model2.goto_functions)
   {
@@ -16,6 +16,7 @@ Date: April 2016
 #include <algorithm>
 
 #include <goto-programs/goto_model.h>
+#include <goto-programs/goto_program_equal.h>
 
 unified_difft::unified_difft(
   const goto_modelt &model_old,
@@ -348,15 +349,27 @@ bool unified_difft::operator()()
     {
       INVARIANT(
         ito->first == itn->first, "old and new function names do not match");
-      unified_diff(
-        itn->first, ito->second->second.body, itn->second->second.body);
+      // equal functions are not diffed any further
+      if(!goto_program_equal(
+           ito->second->second.body, itn->second->second.body))
+        unified_diff(
+          itn->first, ito->second->second.body, itn->second->second.body);
       ++ito;
     }
   }
   for(; ito != old_funcs.end(); ++ito)
     unified_diff(ito->first, ito->second->second.body, empty);
 
-  return !differences_map_.empty();
+  for(const auto &entry : differences_map_)
+  {
+    for(const auto &difference : entry.second)
+    {
+      if(difference != differencet::SAME)
+        return true;
+    }
+  }
+
+  return false;
 }
 
 void unified_difft::output(std::ostream &os) const
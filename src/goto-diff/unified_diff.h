@@ -32,6 +32,8 @@ class unified_difft
 public:
   unified_difft(const goto_modelt &model_old, const goto_modelt &model_new);
 
+  /// Diffs all functions, skipping those that are equal
+  /// \return true if any instruction was added or removed
   bool operator()();
 
   void output(std::ostream &os) const;
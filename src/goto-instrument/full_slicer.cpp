@@ -215,7 +215,7 @@ void full_slicert::add_jumps(
 }
 
 void full_slicert::fixedpoint(
-  goto_functionst &goto_functions,
+  const goto_functionst &goto_functions,
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
@@ -283,8 +283,8 @@ static bool implicit(goto_programt::const_targett target)
   return s.get_identifier()==CPROVER_PREFIX "rounding_mode";
 }
 
-void full_slicert::operator()(
-  goto_functionst &goto_functions,
+void full_slicert::compute_required(
+  const goto_functionst &goto_functions,
   const namespacet &ns,
   slicing_criteriont &criterion)
 {
@@ -328,6 +328,14 @@ void full_slicert::operator()(
 
   // compute the fixedpoint
   fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+}
+
+void full_slicert::operator()(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  slicing_criteriont &criterion)
+{
+  compute_required(goto_functions, ns, criterion);
 
   // now replace those instructions that are not needed
   // by skips
@@ -375,6 +383,39 @@ void full_slicer(
   full_slicert()(goto_functions, ns, criterion);
 }
 
+std::unordered_set<unsigned> full_slicert::irrelevant_instructions(
+  const goto_functionst &goto_functions,
+  const namespacet &ns,
+  slicing_criteriont &criterion)
+{
+  compute_required(goto_functions, ns, criterion);
+
+  std::unordered_set<unsigned> result;
+
+  forall_goto_functions(f_it, goto_functions)
+    if(f_it->second.body_available())
+    {
+      forall_goto_program_instructions(i_it, f_it->second.body)
+      {
+        // function calls are retained as the bodies may start threads,
+        // which the dependence graph does not track
+        if((i_it->is_assign() || i_it->is_goto()) &&
+           !cfg[cfg.entry_map[i_it]].node_required)
+          result.insert(i_it->location_number);
+      }
+    }
+
+  return result;
+}
+
+std::unordered_set<unsigned> full_slicer_irrelevant_instructions(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  assert_assume_criteriont a;
+  return full_slicert().irrelevant_instructions(goto_functions, ns, a);
+}
+
 void full_slicer(
   goto_functionst &goto_functions,
   const namespacet &ns)
@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
 #define CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
 
+#include <unordered_set>
+
 #include <goto-programs/goto_model.h>
 
 void full_slicer(
@@ -41,4 +43,12 @@ void full_slicer(
   const namespacet &ns,
   slicing_criteriont &criterion);
 
+/// Runs the slicing analysis for all assertions and assumptions without
+/// changing the program.
+/// \return location numbers of the assignments and gotos that the full
+///   slicer would remove, which symbolic execution may treat as skips
+std::unordered_set<unsigned> full_slicer_irrelevant_instructions(
+  const goto_functionst &goto_functions,
+  const namespacet &ns);
+
 #endif // CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
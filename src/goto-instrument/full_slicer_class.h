@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <stack>
 #include <vector>
 #include <list>
+#include <unordered_set>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/cfg.h>
@@ -43,6 +44,11 @@ public:
     const namespacet &ns,
     slicing_criteriont &criterion);
 
+  std::unordered_set<unsigned> irrelevant_instructions(
+    const goto_functionst &goto_functions,
+    const namespacet &ns,
+    slicing_criteriont &criterion);
+
 protected:
   struct cfg_nodet
   {
@@ -64,8 +70,13 @@ protected:
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet, irep_id_hash> decl_deadt;
 
+  void compute_required(
+    const goto_functionst &goto_functions,
+    const namespacet &ns,
+    slicing_criteriont &criterion);
+
   void fixedpoint(
-    goto_functionst &goto_functions,
+    const goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
@@ -113,6 +124,18 @@ public:
   }
 };
 
+/// Assumptions constrain the paths that reach the assertions, hence they
+/// are retained when the program is not rewritten but executed with the
+/// irrelevant instructions skipped.
+class assert_assume_criteriont:public slicing_criteriont
+{
+public:
+  virtual bool operator()(goto_programt::const_targett target)
+  {
+    return target->is_assert() || target->is_assume();
+  }
+};
+
 class properties_criteriont:public slicing_criteriont
 {
 public:
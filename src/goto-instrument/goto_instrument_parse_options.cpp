@@ -1216,6 +1216,12 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       const unsigned max_po_trans=
         cmdline.isset("max-po-trans")?
         unsafe_string2unsigned(cmdline.get_value("max-po-trans")):0;
+      const unsigned max_cycle_length=
+        cmdline.isset("max-cycle-length")?
+        unsafe_string2unsigned(cmdline.get_value("max-cycle-length")):0;
+      const unsigned cycle_threads=
+        cmdline.isset("cycle-threads")?
+        unsafe_string2unsigned(cmdline.get_value("cycle-threads")):1;
 
       if(mm=="tso")
       {
@@ -1269,7 +1275,9 @@ void goto_instrument_parse_optionst::instrument_goto_program()
           cmdline.isset("cav11"),
           cmdline.isset("hide-internals"),
           get_message_handler(),
-          cmdline.isset("ignore-arrays"));
+          cmdline.isset("ignore-arrays"),
+          max_cycle_length,
+          cycle_threads);
     }
 
     // Interrupt handler
@@ -1492,6 +1500,8 @@ void goto_instrument_parse_optionst::help()
     "Memory model instrumentations:\n"
     " --mm <tso,pso,rmo,power>     instruments a weak memory model\n"
     " --scc                        detects critical cycles per SCC (one thread per SCC)\n" // NOLINT(*)
+    " --cycle-threads n            explores critical cycles with n threads\n"
+    " --max-cycle-length n         only collects cycles of at most n events\n"
     " --one-event-per-cycle        only instruments one event per cycle\n"
     " --minimum-interference       instruments an optimal number of events\n"
     " --my-events                  only instruments events whose ids appear in inst.evt\n" // NOLINT(*)
@@ -42,6 +42,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(unwinding-assertions)(partial-loops)(continue-as-loops)" \
   "(log):" \
   "(max-var):(max-po-trans):(ignore-arrays)" \
+  "(max-cycle-length):(cycle-threads):" \
   "(cfg-kill)(no-dependencies)(force-loop-duplication)" \
   "(call-graph)" \
   "(no-po-rendering)(render-cluster-file)(render-cluster-function)" \
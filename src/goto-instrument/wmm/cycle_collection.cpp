@@ -13,6 +13,12 @@ Date: 2012
 
 #include "event_graph.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <util/message.h>
 
 /// after the collection, eliminates the executions forbidden by an indirect
@@ -41,9 +47,9 @@ void event_grapht::graph_explorert::filter_thin_air(
   for(std::set<event_idt>::const_iterator it=thin_air_events.begin();
       it!=thin_air_events.end();
       ++it)
-    egraph.message.debug()<<egraph[*it]<<";";
+    message.debug()<<egraph[*it]<<";";
 
-  egraph.message.debug() << messaget::eom;
+  message.debug() << messaget::eom;
 #endif
 }
 
@@ -82,29 +88,160 @@ void event_grapht::graph_explorert::collect_cycles(
   if(order->empty())
     return;
 
-  for(std::list<event_idt>::const_iterator
-      st_it=order->begin();
-      st_it!=order->end();
-      ++st_it)
-  {
-    event_idt source=*st_it;
-    egraph.message.debug() << "explore " << egraph[source].id << messaget::eom;
-    backtrack(set_of_cycles, source, source,
-      false, max_po_trans, false, false, false, "", model);
+  const std::vector<event_idt> sources(order->begin(), order->end());
 
-    while(!marked_stack.empty())
+  /* debug output is not thread-safe */
+  if(egraph.exploration_threads>1 &&
+     sources.size()>1 &&
+     egraph.message.get_message_handler().get_verbosity()<messaget::M_DEBUG)
+  {
+    explore_concurrently(set_of_cycles, sources, model);
+  }
+  else
+  {
+    for(std::size_t i=0; i<sources.size(); i++)
     {
-      event_idt up=marked_stack.top();
-      mark[up]=false;
-      marked_stack.pop();
+      explore(set_of_cycles, sources[i], model);
+      report_progress(i+1, sources.size(), set_of_cycles.size());
     }
   }
 
+  if(truncated_paths!=0)
+    egraph.message.warning() << truncated_paths
+                             << " paths cut at the maximal cycle length "
+                             << max_cycle_length << messaget::eom;
+
   /* end of collection -- remove spurious by thin-air cycles */
   if(egraph.filter_thin_air)
     filter_thin_air(set_of_cycles);
 }
 
+void event_grapht::graph_explorert::explore(
+  std::set<critical_cyclet> &set_of_cycles,
+  event_idt source,
+  memory_modelt model)
+{
+  message.debug() << "explore " << egraph[source].id << messaget::eom;
+  backtrack(set_of_cycles, source, source,
+    false, max_po_trans, false, false, false, "", model);
+
+  while(!marked_stack.empty())
+  {
+    event_idt up=marked_stack.top();
+    mark[up]=false;
+    marked_stack.pop();
+  }
+}
+
+/// reports the progress of the collection, at most once per second
+void event_grapht::graph_explorert::report_progress(
+  std::size_t explored,
+  std::size_t total,
+  std::size_t cycles)
+{
+  const auto now=std::chrono::steady_clock::now();
+  if(explored!=total && now-last_report<std::chrono::seconds(1))
+    return;
+
+  last_report=now;
+  egraph.message.progress() << "explored " << explored << " of " << total
+                            << " start events, " << cycles << " cycles"
+                            << messaget::eom;
+}
+
+/// Explorations from different start events are independent: each worker
+/// explores with its own copy of this explorer, and takes the next
+/// unexplored start event when done. The cycles found from each start event
+/// are numbered as in a sequential collection.
+void event_grapht::graph_explorert::explore_concurrently(
+  std::set<critical_cyclet> &set_of_cycles,
+  const std::vector<event_idt> &sources,
+  memory_modelt model)
+{
+  /* the data dependencies are looked up with operator[] during the
+     exploration, which must not insert concurrently */
+  for(event_idt e=0; e<egraph.size(); e++)
+    egraph.map_data_dp[egraph[e].thread];
+
+  struct resultt
+  {
+    std::set<critical_cyclet> cycles;
+    unsigned cycle_nb;
+  };
+
+  std::vector<resultt> results(sources.size());
+  std::atomic<std::size_t> next(0);
+  std::atomic<std::size_t> explored(0);
+  std::atomic<std::size_t> cycles(0);
+  std::mutex mutex;
+  std::condition_variable finished;
+
+  const std::size_t number_of_workers=
+    std::min<std::size_t>(egraph.exploration_threads, sources.size());
+  std::vector<std::unique_ptr<graph_explorert>> workers;
+  std::vector<std::thread> threads;
+
+  for(std::size_t w=0; w<number_of_workers; w++)
+  {
+    workers.push_back(clone());
+    graph_explorert *worker=workers.back().get();
+    worker->message=messaget();
+    worker->concurrent=true;
+
+    threads.push_back(std::thread([&, worker]()
+    {
+      for(std::size_t i=next++; i<sources.size(); i=next++)
+      {
+        worker->cycle_nb=0;
+        worker->explore(results[i].cycles, sources[i], model);
+        results[i].cycle_nb=worker->cycle_nb;
+        cycles+=results[i].cycles.size();
+
+        if(++explored==sources.size())
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          finished.notify_one();
+        }
+      }
+    }));
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!finished.wait_for(
+            lock,
+            std::chrono::seconds(1),
+            [&]() { return explored==sources.size(); }))
+      report_progress(explored, sources.size(), cycles);
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  for(std::size_t i=0; i<sources.size(); i++)
+  {
+    for(const auto &cycle : results[i].cycles)
+    {
+      critical_cyclet renumbered=cycle;
+      renumbered.id+=cycle_nb;
+      set_of_cycles.insert(renumbered);
+    }
+    cycle_nb+=results[i].cycle_nb;
+  }
+
+  for(const auto &worker : workers)
+  {
+    thin_air_events.insert(
+      worker->thin_air_events.begin(), worker->thin_air_events.end());
+    truncated_paths+=worker->truncated_paths;
+
+    for(const auto &edge : worker->pruned_com_edges)
+      egraph.remove_com_edge(edge.first, edge.second);
+  }
+
+  report_progress(sources.size(), sources.size(), set_of_cycles.size());
+}
+
 /// extracts a (whole, unreduced) cycle from the stack. Note: it may not be a
 /// real cycle yet -- we cannot check the size before a call to this function.
 event_grapht::critical_cyclet event_grapht::graph_explorert::extract_cycle(
@@ -121,7 +258,7 @@ event_grapht::critical_cyclet event_grapht::graph_explorert::extract_cycle(
     event_idt current_vertex=stack.top();
     stack.pop();
 
-    egraph.message.debug() << "extract: "
+    message.debug() << "extract: "
                            << egraph[current_vertex].get_operation()
                            << egraph[current_vertex].variable << "@"
                            << egraph[current_vertex].thread << "~"
@@ -161,18 +298,18 @@ bool event_grapht::graph_explorert::backtrack(
   memory_modelt model)
 {
 #ifdef DEBUG
-  egraph.message.debug() << std::string(80, '-');
-  egraph.message.debug() << messaget::eom;
-  egraph.message.debug() << "marked size:" << marked_stack.size()
+  message.debug() << std::string(80, '-');
+  message.debug() << messaget::eom;
+  message.debug() << "marked size:" << marked_stack.size()
     << messaget::eom;
   std::stack<event_idt> tmp;
   while(!point_stack.empty())
   {
-    egraph.message.debug() << point_stack.top() << " | ";
+    message.debug() << point_stack.top() << " | ";
     tmp.push(point_stack.top());
     point_stack.pop();
   }
-  egraph.message.debug() << messaget::eom;
+  message.debug() << messaget::eom;
   while(!tmp.empty())
   {
     point_stack.push(tmp.top());
@@ -180,11 +317,11 @@ bool event_grapht::graph_explorert::backtrack(
   }
   while(!marked_stack.empty())
   {
-    egraph.message.debug() << marked_stack.top() << " | ";
+    message.debug() << marked_stack.top() << " | ";
     tmp.push(marked_stack.top());
     marked_stack.pop();
   }
-  egraph.message.debug() << messaget::eom;
+  message.debug() << messaget::eom;
   while(!tmp.empty())
   {
     marked_stack.push(tmp.top());
@@ -196,7 +333,7 @@ bool event_grapht::graph_explorert::backtrack(
   if(filtering(vertex))
     return false;
 
-  egraph.message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
+  message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
     <<egraph[source].id<<"#"<<source<<" lw:"<<lwfence_met<<" unsafe:"
     <<unsafe_met << messaget::eom;
   bool f=false;
@@ -219,6 +356,12 @@ bool event_grapht::graph_explorert::backtrack(
   if(max_var!=0 && point_stack.size()>max_var*3)
     return false;
 
+  if(max_cycle_length!=0 && point_stack.size()>=max_cycle_length)
+  {
+    truncated_paths++;
+    return false;
+  }
+
   /* we only explore shared variables */
   if(!this_vertex.local)
   {
@@ -388,7 +531,7 @@ bool event_grapht::graph_explorert::backtrack(
              not_thin_air && new_cycle.is_cycle() &&
              new_cycle.is_unsafe(model) /*&& new_cycle.is_unsafe_asm(model)*/)
           {
-            egraph.message.debug() << new_cycle.print_name(model, false)
+            message.debug() << new_cycle.print_name(model, false)
               << messaget::eom;
             set_of_cycles.insert(new_cycle);
 #if 0
@@ -419,11 +562,17 @@ bool event_grapht::graph_explorert::backtrack(
       /* we then visit via com transitions, if existing */
       for(wmm_grapht::edgest::const_iterator
           w_it=egraph.com_out(vertex).begin();
-          w_it!=egraph.com_out(vertex).end(); w_it++)
+          w_it!=egraph.com_out(vertex).end(); )
       {
-        const event_idt w=w_it->first;
+        /* advance first, as the edge may be removed */
+        const event_idt w=(w_it++)->first;
         if(w < source)
-          egraph.remove_com_edge(vertex, w);
+        {
+          if(concurrent)
+            pruned_com_edges.insert(std::make_pair(vertex, w));
+          else
+            egraph.remove_com_edge(vertex, w);
+        }
         else if(w==source && point_stack.size()>=4 &&
                 (unsafe_met_updated ||
                  this_vertex.unsafe_pair(egraph[source], model)))
@@ -441,7 +590,7 @@ bool event_grapht::graph_explorert::backtrack(
              not_thin_air && new_cycle.is_cycle() &&
              new_cycle.is_unsafe(model) /*&& new_cycle.is_unsafe_asm(model)*/)
           {
-            egraph.message.debug() << new_cycle.print_name(model, false)
+            message.debug() << new_cycle.print_name(model, false)
               << messaget::eom;
             set_of_cycles.insert(new_cycle);
 #if 0
@@ -279,7 +279,9 @@ bool event_grapht::critical_cyclet::check_BC(
 
 bool event_grapht::critical_cyclet::is_unsafe(memory_modelt model, bool fast)
 {
+#ifdef DEBUG
   egraph.message.debug() << "cycle is safe?" << messaget::eom;
+#endif
   bool unsafe_met=false;
 
   /* critical cycles contain at least 4 events */
@@ -563,7 +565,9 @@ bool event_grapht::critical_cyclet::is_unsafe_asm(
   memory_modelt model,
   bool fast)
 {
+#ifdef DEBUG
   egraph.message.debug() << "cycle is safe?" << messaget::eom;
+#endif
   bool unsafe_met=false;
   unsigned char fences_met=0;
 
@@ -14,19 +14,23 @@ Date: 2012
 #ifndef CPROVER_GOTO_INSTRUMENT_WMM_EVENT_GRAPH_H
 #define CPROVER_GOTO_INSTRUMENT_WMM_EVENT_GRAPH_H
 
+#include <chrono>
 #include <list>
 #include <set>
 #include <map>
 #include <iosfwd>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <util/graph.h>
 #include <util/invariant.h>
+#include <util/message.h>
 
 #include "abstract_event.h"
 #include "data_dp.h"
 #include "wmm.h"
 
-class messaget;
 class namespacet;
 
 typedef grapht<abstract_eventt> wmm_grapht;
@@ -261,6 +265,20 @@ protected:
     /* parameters limiting the exploration */
     unsigned max_var;
     unsigned max_po_trans;
+    unsigned max_cycle_length;
+
+    /* debug output; silenced in the workers of a concurrent collection */
+    messaget message;
+
+    /* set in the workers of a concurrent collection: the graph is shared,
+       so com edges are pruned only once all workers are done */
+    bool concurrent;
+    std::set<std::pair<event_idt, event_idt> > pruned_com_edges;
+
+    /* number of paths cut by max_cycle_length */
+    std::size_t truncated_paths;
+
+    std::chrono::steady_clock::time_point last_report;
 
     /* constraints for graph exploration */
     std::map<irep_idt, unsigned char> writes_per_variable;
@@ -279,6 +297,12 @@ protected:
       return order;
     }
 
+    /* copy of this explorer (including its filtering) for a worker */
+    virtual std::unique_ptr<graph_explorert> clone() const
+    {
+      return std::unique_ptr<graph_explorert>(new graph_explorert(*this));
+    }
+
     /* number of cycles met so far */
     unsigned cycle_nb;
 
@@ -291,6 +315,23 @@ protected:
        indirect thin-air */
     void filter_thin_air(std::set<critical_cyclet> &set_of_cycles);
 
+    /* all the cycles through source, then unmarks the events */
+    void explore(
+      std::set<critical_cyclet> &set_of_cycles,
+      event_idt source,
+      memory_modelt model);
+
+    /* explores the sources on egraph.exploration_threads workers */
+    void explore_concurrently(
+      std::set<critical_cyclet> &set_of_cycles,
+      const std::vector<event_idt> &sources,
+      memory_modelt model);
+
+    void report_progress(
+      std::size_t explored,
+      std::size_t total,
+      std::size_t cycles);
+
   public:
     graph_explorert(
       event_grapht &_egraph,
@@ -299,6 +340,10 @@ protected:
       egraph(_egraph),
       max_var(_max_var),
       max_po_trans(_max_po_trans),
+      max_cycle_length(_egraph.max_cycle_length),
+      message(_egraph.message),
+      concurrent(false),
+      truncated_paths(0),
       cycle_nb(0)
     {
     }
@@ -348,6 +393,11 @@ protected:
       return filter.find(u)==filter.end();
     }
 
+    std::unique_ptr<graph_explorert> clone() const
+    {
+      return std::unique_ptr<graph_explorert>(new graph_conc_explorert(*this));
+    }
+
     std::list<event_idt>* initial_filtering(std::list<event_idt>* order)
     {
       static std::list<event_idt> new_order;
@@ -387,12 +437,18 @@ public:
     ignore_arrays(false),
     filter_thin_air(true),
     filter_uniproc(true),
+    max_cycle_length(0),
+    exploration_threads(1),
     message(_message)
   {
   }
 
   bool filter_thin_air;
   bool filter_uniproc;
+  /* maximal number of events in a collected cycle (0: no limit) */
+  unsigned max_cycle_length;
+  /* number of threads exploring the start events of the cycles */
+  unsigned exploration_threads;
   messaget &message;
 
   /* data dependencies per thread */
@@ -121,7 +121,9 @@ void weak_memory(
   bool cav11_option,
   bool hide_internals,
   message_handlert &message_handler,
-  bool ignore_arrays)
+  bool ignore_arrays,
+  unsigned max_cycle_length,
+  unsigned cycle_threads)
 {
   messaget message(message_handler);
 
@@ -159,6 +161,9 @@ void weak_memory(
   else
     instrumenter.set_parameters_collection(max_thds, ignore_arrays);
 
+  instrumenter.egraph.max_cycle_length=max_cycle_length;
+  instrumenter.egraph.exploration_threads=cycle_threads;
+
   if(SCC)
   {
     instrumenter.collect_cycles_by_SCCs(model);
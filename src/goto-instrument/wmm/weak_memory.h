@@ -43,7 +43,9 @@ void weak_memory(
   bool cav11_option,
   bool hide_internals,
   message_handlert &,
-  bool ignore_arrays);
+  bool ignore_arrays,
+  unsigned max_cycle_length=0,
+  unsigned cycle_threads=1);
 
 void introduce_temporaries(
   value_setst &,
@@ -11,11 +11,15 @@ Date: June 2003
 #include "goto_convert_functions.h"
 
 #include <cassert>
+#include <set>
+#include <stack>
 
 #include <util/base_type.h>
 #include <util/std_code.h>
 #include <util/symbol_table.h>
 #include <util/prefix.h>
+#include <util/find_symbols.h>
+#include <util/cprover_prefix.h>
 
 #include "goto_inline.h"
 
@@ -32,6 +36,18 @@ goto_convert_functionst::~goto_convert_functionst()
 {
 }
 
+bool goto_convert_functionst::is_function_to_convert(const symbolt &symbol)
+{
+  return
+    !symbol.is_type &&
+    !symbol.is_macro &&
+    symbol.type.id()==ID_code &&
+    (symbol.mode==ID_C ||
+     symbol.mode==ID_cpp ||
+     symbol.mode==ID_java ||
+     symbol.mode=="jsil");
+}
+
 void goto_convert_functionst::goto_convert()
 {
   // warning! hash-table iterators are not stable
@@ -41,13 +57,7 @@ void goto_convert_functionst::goto_convert()
 
   forall_symbols(it, symbol_table.symbols)
   {
-    if(!it->second.is_type &&
-       !it->second.is_macro &&
-       it->second.type.id()==ID_code &&
-       (it->second.mode==ID_C ||
-        it->second.mode==ID_cpp ||
-        it->second.mode==ID_java ||
-        it->second.mode=="jsil"))
+    if(is_function_to_convert(it->second))
       symbol_list.push_back(it->first);
   }
 
@@ -70,6 +80,56 @@ void goto_convert_functionst::goto_convert()
   #endif
 }
 
+/// Converts \p entry_point and, transitively, each function that a
+/// converted body calls or takes the address of. Functions with the
+/// CPROVER prefix are always converted, as later instrumentation may
+/// introduce calls to them.
+void goto_convert_functionst::goto_convert_reachable(
+  const irep_idt &entry_point)
+{
+  std::set<irep_idt> done;
+  std::stack<irep_idt> queue;
+
+  queue.push(entry_point);
+
+  forall_symbols(it, symbol_table.symbols)
+  {
+    if(is_function_to_convert(it->second) &&
+       has_prefix(id2string(it->first), CPROVER_PREFIX))
+      queue.push(it->first);
+  }
+
+  while(!queue.empty())
+  {
+    const irep_idt id=queue.top();
+    queue.pop();
+
+    if(!done.insert(id).second)
+      continue;
+
+    convert_function(id);
+
+    find_symbols_sett referenced;
+    forall_goto_program_instructions(
+      i_it, functions.function_map[id].body)
+    {
+      find_symbols(i_it->code, referenced);
+      find_symbols(i_it->guard, referenced);
+    }
+
+    for(const auto &r : referenced)
+    {
+      const symbolt *symbol;
+      if(done.find(r)==done.end() &&
+         !ns.lookup(r, symbol) &&
+         is_function_to_convert(*symbol))
+        queue.push(r);
+    }
+  }
+
+  functions.compute_location_numbers();
+}
+
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
 {
   forall_goto_program_instructions(i_it, goto_program)
@@ -302,3 +362,39 @@ void goto_convert(
   if(message_handler.get_message_count(messaget::M_ERROR)!=errors_before)
     throw 0;
 }
+
+void goto_convert_reachable(
+  const irep_idt &entry_point,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  const unsigned errors_before=
+    message_handler.get_message_count(messaget::M_ERROR);
+
+  goto_convert_functionst goto_convert_functions(
+    symbol_table, functions, message_handler);
+
+  try
+  {
+    goto_convert_functions.goto_convert_reachable(entry_point);
+  }
+
+  catch(int)
+  {
+    goto_convert_functions.error();
+  }
+
+  catch(const char *e)
+  {
+    goto_convert_functions.error() << e << messaget::eom;
+  }
+
+  catch(const std::string &e)
+  {
+    goto_convert_functions.error() << e << messaget::eom;
+  }
+
+  if(message_handler.get_message_count(messaget::M_ERROR)!=errors_before)
+    throw 0;
+}
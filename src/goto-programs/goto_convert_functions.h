@@ -35,10 +35,18 @@ void goto_convert(
   goto_functionst &functions,
   message_handlert &);
 
+// convert the functions reachable from the given one
+void goto_convert_reachable(
+  const irep_idt &entry_point,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &);
+
 class goto_convert_functionst:public goto_convertt
 {
 public:
   void goto_convert();
+  void goto_convert_reachable(const irep_idt &entry_point);
   void convert_function(const irep_idt &identifier);
 
   goto_convert_functionst(
@@ -52,6 +60,7 @@ protected:
   goto_functionst &functions;
 
   static bool hide(const goto_programt &);
+  static bool is_function_to_convert(const symbolt &);
 
   //
   // function calls
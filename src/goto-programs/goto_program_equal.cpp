@@ -0,0 +1,63 @@
+/*******************************************************************\
+
+Module: Equality of goto programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Equality of goto programs
+
+#include "goto_program_equal.h"
+
+#include <unordered_map>
+
+typedef std::unordered_map<const goto_programt::instructiont *, std::size_t>
+  positionst;
+
+static void number_instructions(
+  const goto_programt &goto_program,
+  positionst &positions)
+{
+  std::size_t position=0;
+  forall_goto_program_instructions(it, goto_program)
+    positions[&*it]=position++;
+}
+
+bool goto_program_equal(
+  const goto_programt &goto_program1,
+  const goto_programt &goto_program2)
+{
+  if(goto_program1.instructions.size()!=goto_program2.instructions.size())
+    return false;
+
+  positionst positions1, positions2;
+  number_instructions(goto_program1, positions1);
+  number_instructions(goto_program2, positions2);
+
+  goto_programt::instructionst::const_iterator
+    it2=goto_program2.instructions.begin();
+  forall_goto_program_instructions(it1, goto_program1)
+  {
+    if(it1->type!=it2->type ||
+       it1->code!=it2->code ||
+       it1->guard!=it2->guard ||
+       it1->function!=it2->function ||
+       it1->targets.size()!=it2->targets.size())
+      return false;
+
+    goto_programt::instructiont::targetst::const_iterator t_it2=
+      it2->targets.begin();
+    for(const auto &target : it1->targets)
+    {
+      if(positions1[&*target]!=positions2[&**t_it2])
+        return false;
+      ++t_it2;
+    }
+
+    ++it2;
+  }
+
+  return true;
+}
@@ -0,0 +1,25 @@
+/*******************************************************************\
+
+Module: Equality of goto programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Equality of goto programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_PROGRAM_EQUAL_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_PROGRAM_EQUAL_H
+
+#include "goto_program.h"
+
+/// Compares the type, code, guard and function of all instructions, as
+/// well as the jump targets, which are compared by their position as the
+/// programs are separate copies. Source locations and labels are ignored.
+/// \return true if both programs agree in all of the above
+bool goto_program_equal(
+  const goto_programt &goto_program1,
+  const goto_programt &goto_program2);
+
+#endif // CPROVER_GOTO_PROGRAMS_GOTO_PROGRAM_EQUAL_H
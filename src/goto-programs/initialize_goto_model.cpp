@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/language.h>
 #include <util/config.h>
+#include <util/profiler.h>
 #include <util/unicode.h>
 
 #include <langapi/mode.h>
@@ -96,6 +97,8 @@ goto_modelt initialize_goto_model(
 
       msg.status() << "Parsing " << filename << messaget::eom;
 
+      profilert::scopet profiler_scope(profiler, "parsing");
+
       if(language.parse(infile, filename))
       {
         msg.error() << "PARSING ERROR" << messaget::eom;
@@ -107,6 +110,8 @@ goto_modelt initialize_goto_model(
 
     msg.status() << "Converting" << messaget::eom;
 
+    profilert::scopet profiler_scope(profiler, "typechecking");
+
     if(language_files.typecheck(goto_model.symbol_table))
     {
       msg.error() << "CONVERSION ERROR" << messaget::eom;
@@ -161,18 +166,39 @@ goto_modelt initialize_goto_model(
     throw 0;
   }
 
-  if(language_files.final(goto_model.symbol_table))
   {
-    msg.error() << "FINAL STAGE CONVERSION ERROR" << messaget::eom;
-    throw 0;
+    profilert::scopet profiler_scope(profiler, "typechecking");
+
+    if(language_files.final(goto_model.symbol_table))
+    {
+      msg.error() << "FINAL STAGE CONVERSION ERROR" << messaget::eom;
+      throw 0;
+    }
   }
 
   msg.status() << "Generating GOTO Program" << messaget::eom;
 
-  goto_convert(
-    goto_model.symbol_table,
-    goto_model.goto_functions,
-    message_handler);
+  profilert::scopet profiler_scope(profiler, "goto conversion");
+
+  // Functions that cannot be reached from the entry point need not be
+  // converted at all, which saves a lot of time on large code bases when
+  // only a small part of them is verified (e.g., using --function).
+  if(cmdline.isset("convert-only-reachable") &&
+     goto_model.symbol_table.has_symbol(goto_functionst::entry_point()))
+  {
+    goto_convert_reachable(
+      goto_functionst::entry_point(),
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      message_handler);
+  }
+  else
+  {
+    goto_convert(
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      message_handler);
+  }
 
   // stupid hack
   config.set_object_bits_from_symbol_table(
@@ -294,7 +294,7 @@ void interpretert::step()
        call_stack.top().return_value_address!=0)
     {
       mp_vectort rhs;
-      evaluate(pc->code.op0(), rhs);
+      evaluate_program_expr(pc->code.op0(), rhs);
       assign(call_stack.top().return_value_address, rhs);
     }
 
@@ -657,7 +657,7 @@ void interpretert::execute_assign()
     to_code_assign(pc->code);
 
   mp_vectort rhs;
-  evaluate(code_assign.rhs(), rhs);
+  evaluate_program_expr(code_assign.rhs(), rhs);
 
   if(!rhs.empty())
   {
@@ -792,7 +792,7 @@ void interpretert::execute_function_call()
   argument_values.resize(function_call.arguments().size());
 
   for(std::size_t i=0; i<function_call.arguments().size(); i++)
-    evaluate(function_call.arguments()[i], argument_values[i]);
+    evaluate_program_expr(function_call.arguments()[i], argument_values[i]);
 
   // do the call
 
@@ -0,0 +1,430 @@
+/*******************************************************************\
+
+Module: Register bytecode for the GOTO interpreter
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Register bytecode for the GOTO interpreter
+
+#include "interpreter_bytecode.h"
+
+#include <limits>
+
+#include <util/arith_tools.h>
+#include <util/std_types.h>
+
+static const interpreter_bytecodet::valuet max_value=
+  std::numeric_limits<interpreter_bytecodet::valuet>::max();
+static const interpreter_bytecodet::valuet min_value=
+  std::numeric_limits<interpreter_bytecodet::valuet>::min();
+
+/// Types whose values the fast path represents as a single 64-bit cell.
+bool interpreter_bytecodet::supported_type(const typet &type)
+{
+  if(type.id()==ID_bool)
+    return true;
+  else if(type.id()==ID_signedbv ||
+          type.id()==ID_unsignedbv ||
+          type.id()==ID_c_bool)
+  {
+    const std::size_t width=to_bitvector_type(type).get_width();
+    return width>0 && width<=64;
+  }
+
+  return false;
+}
+
+std::size_t interpreter_bytecodet::emit(
+  opcodet opcode,
+  std::size_t dest,
+  std::size_t op0,
+  std::size_t op1,
+  valuet constant,
+  std::size_t width)
+{
+  instructiont instruction;
+  instruction.opcode=opcode;
+  instruction.width=width;
+  instruction.dest=dest;
+  instruction.op0=op0;
+  instruction.op1=op1;
+  instruction.constant=constant;
+  instructions.push_back(instruction);
+  return instructions.size()-1;
+}
+
+bool interpreter_bytecodet::compile(const exprt &expr)
+{
+  instructions.clear();
+  symbols.clear();
+  number_of_registers=0;
+
+  result=new_register();
+  if(compile_rec(expr, result))
+  {
+    instructions.clear();
+    symbols.clear();
+    number_of_registers=0;
+    return true;
+  }
+
+  return false;
+}
+
+/// Emits code that leaves the value of `expr` in register `dest`. Only
+/// the operators that `interpretert::evaluate` implements are lowered,
+/// with the same (unbounded, i.e., non-wrapping) arithmetic.
+bool interpreter_bytecodet::compile_rec(
+  const exprt &expr,
+  std::size_t dest)
+{
+  if(!supported_type(expr.type()))
+    return true;
+
+  const irep_idt &id=expr.id();
+
+  if(id==ID_constant)
+  {
+    mp_integer value;
+
+    if(expr.type().id()==ID_bool)
+      value=expr.is_true() ? 1 : 0;
+    else if(expr.type().id()==ID_c_bool)
+      value=binary2integer(
+        id2string(to_constant_expr(expr).get_value()), false);
+    else if(to_integer(expr, value))
+      return true;
+
+    if(!value.is_long())
+      return true;
+
+    emit(opcodet::CONSTANT, dest, 0, 0, value.to_long());
+    return false;
+  }
+  else if(id==ID_symbol)
+  {
+    symbols.push_back(to_symbol_expr(expr));
+    emit(opcodet::LOAD, dest, 0, 0, symbols.size()-1);
+    return false;
+  }
+  else if(id==ID_plus || id==ID_mult ||
+          id==ID_bitand || id==ID_bitor || id==ID_bitxor)
+  {
+    if(expr.operands().size()<(id==ID_plus || id==ID_mult ? 1 : 2))
+      return true;
+
+    const opcodet opcode=
+      id==ID_plus ? opcodet::ADD :
+      id==ID_mult ? opcodet::MUL :
+      id==ID_bitand ? opcodet::BITAND :
+      id==ID_bitor ? opcodet::BITOR : opcodet::BITXOR;
+
+    if(compile_rec(expr.op0(), dest))
+      return true;
+
+    for(std::size_t i=1; i<expr.operands().size(); i++)
+    {
+      const std::size_t op=new_register();
+      if(compile_rec(expr.operands()[i], op))
+        return true;
+      emit(opcode, dest, dest, op);
+    }
+
+    return false;
+  }
+  else if(id==ID_minus || id==ID_div ||
+          id==ID_shl || id==ID_shr || id==ID_lshr ||
+          id==ID_equal || id==ID_notequal ||
+          id==ID_lt || id==ID_le || id==ID_gt || id==ID_ge)
+  {
+    if(expr.operands().size()!=2)
+      return true;
+
+    const opcodet opcode=
+      id==ID_minus ? opcodet::SUB :
+      id==ID_div ? opcodet::DIV :
+      id==ID_shl ? opcodet::SHL :
+      (id==ID_shr || id==ID_lshr) ? opcodet::LSHR :
+      id==ID_equal ? opcodet::EQUAL :
+      id==ID_notequal ? opcodet::NOTEQUAL :
+      id==ID_lt ? opcodet::LT :
+      id==ID_le ? opcodet::LE :
+      id==ID_gt ? opcodet::GT : opcodet::GE;
+
+    const bool is_shift=opcode==opcodet::SHL || opcode==opcodet::LSHR;
+    if(is_shift && expr.op0().type().id()==ID_bool)
+      return true;
+
+    const std::size_t op1=new_register();
+    if(compile_rec(expr.op0(), dest) ||
+       compile_rec(expr.op1(), op1))
+      return true;
+
+    emit(
+      opcode,
+      dest,
+      dest,
+      op1,
+      0,
+      is_shift ? to_bitvector_type(expr.op0().type()).get_width() : 0);
+    return false;
+  }
+  else if(id==ID_unary_minus || id==ID_not || id==ID_typecast)
+  {
+    if(expr.operands().size()!=1)
+      return true;
+
+    if(compile_rec(expr.op0(), dest))
+      return true;
+
+    if(id==ID_unary_minus)
+      emit(opcodet::NEG, dest, dest);
+    else if(id==ID_not)
+      emit(opcodet::NOT, dest, dest);
+    else if(expr.type().id()==ID_signedbv)
+      emit(
+        opcodet::CAST_SIGNED,
+        dest,
+        dest,
+        0,
+        0,
+        to_signedbv_type(expr.type()).get_width());
+    else if(expr.type().id()==ID_unsignedbv)
+      emit(
+        opcodet::CAST_UNSIGNED,
+        dest,
+        dest,
+        0,
+        0,
+        to_unsignedbv_type(expr.type()).get_width());
+    else
+      emit(opcodet::CAST_BOOL, dest, dest);
+
+    return false;
+  }
+  else if(id==ID_and || id==ID_or)
+  {
+    // short-circuit evaluation, as operands beyond the deciding one must
+    // not be read (reading marks memory cells as inputs)
+    if(expr.operands().empty())
+      return true;
+
+    const opcodet jump=
+      id==ID_and ? opcodet::JUMP_IF_ZERO : opcodet::JUMP_IF_NONZERO;
+    std::vector<std::size_t> exits;
+
+    for(const auto &op : expr.operands())
+    {
+      if(compile_rec(op, dest))
+        return true;
+      exits.push_back(emit(jump, 0, dest));
+    }
+
+    emit(opcodet::CONSTANT, dest, 0, 0, id==ID_and ? 1 : 0);
+    const std::size_t done=emit(opcodet::JUMP, 0);
+
+    for(const auto exit : exits)
+      instructions[exit].constant=instructions.size();
+    emit(opcodet::CONSTANT, dest, 0, 0, id==ID_and ? 0 : 1);
+
+    instructions[done].constant=instructions.size();
+    return false;
+  }
+  else if(id==ID_if)
+  {
+    if(expr.operands().size()!=3)
+      return true;
+
+    if(compile_rec(expr.op0(), dest))
+      return true;
+    const std::size_t to_false=emit(opcodet::JUMP_IF_ZERO, 0, dest);
+
+    if(compile_rec(expr.op1(), dest))
+      return true;
+    const std::size_t done=emit(opcodet::JUMP, 0);
+
+    instructions[to_false].constant=instructions.size();
+    if(compile_rec(expr.op2(), dest))
+      return true;
+
+    instructions[done].constant=instructions.size();
+    return false;
+  }
+
+  return true;
+}
+
+bool interpreter_bytecodet::execute(
+  const loadert &load,
+  std::vector<valuet> &registers,
+  valuet &value) const
+{
+  if(registers.size()<number_of_registers)
+    registers.resize(number_of_registers);
+
+  valuet *const r=registers.data();
+  const std::size_t end=instructions.size();
+
+  for(std::size_t pc=0; pc<end; pc++)
+  {
+    const instructiont &i=instructions[pc];
+    const valuet a=r[i.op0];
+    const valuet b=r[i.op1];
+
+    switch(i.opcode)
+    {
+    case opcodet::CONSTANT:
+      r[i.dest]=i.constant;
+      break;
+
+    case opcodet::LOAD:
+      if(load(symbols[static_cast<std::size_t>(i.constant)], r[i.dest]))
+        return true;
+      break;
+
+    case opcodet::ADD:
+      if((b>0 && a>max_value-b) || (b<0 && a<min_value-b))
+        return true;
+      r[i.dest]=a+b;
+      break;
+
+    case opcodet::SUB:
+      if((b<0 && a>max_value+b) || (b>0 && a<min_value+b))
+        return true;
+      r[i.dest]=a-b;
+      break;
+
+    case opcodet::MUL:
+      {
+        // conservative: both factors must fit into 32 bits
+        const valuet bound=valuet(1)<<31;
+        if(a>=bound || a<=-bound || b>=bound || b<=-bound)
+          return true;
+        r[i.dest]=a*b;
+      }
+      break;
+
+    case opcodet::DIV:
+      if(b==0 || (a==min_value && b==-1))
+        return true;
+      r[i.dest]=a/b;
+      break;
+
+    case opcodet::NEG:
+      if(a==min_value)
+        return true;
+      r[i.dest]=-a;
+      break;
+
+    case opcodet::BITAND:
+    case opcodet::BITOR:
+    case opcodet::BITXOR:
+      // the mp_integer versions are only defined on non-negative values
+      if(a<0 || b<0)
+        return true;
+      r[i.dest]=
+        i.opcode==opcodet::BITAND ? (a&b) :
+        i.opcode==opcodet::BITOR ? (a|b) : (a^b);
+      break;
+
+    case opcodet::SHL:
+      {
+        if(b<0 || b>=64 || (static_cast<std::size_t>(b)>i.width && a!=0))
+          return true;
+        valuet shifted=static_cast<valuet>(
+          static_cast<std::uint64_t>(a)<<b);
+        if(i.width<64)
+          shifted&=(valuet(1)<<i.width)-1;
+        r[i.dest]=shifted;
+      }
+      break;
+
+    case opcodet::LSHR:
+      {
+        if(b<0 || b>=64 || static_cast<std::size_t>(b)>i.width)
+          return true;
+        const std::uint64_t shifted=static_cast<std::uint64_t>(a)>>b;
+        if(shifted>static_cast<std::uint64_t>(max_value))
+          return true;
+        r[i.dest]=static_cast<valuet>(shifted);
+      }
+      break;
+
+    case opcodet::EQUAL:
+      r[i.dest]=(a==b);
+      break;
+
+    case opcodet::NOTEQUAL:
+      r[i.dest]=(a!=b);
+      break;
+
+    case opcodet::LT:
+      r[i.dest]=(a<b);
+      break;
+
+    case opcodet::LE:
+      r[i.dest]=(a<=b);
+      break;
+
+    case opcodet::GT:
+      r[i.dest]=(a>b);
+      break;
+
+    case opcodet::GE:
+      r[i.dest]=(a>=b);
+      break;
+
+    case opcodet::NOT:
+      r[i.dest]=(a==0);
+      break;
+
+    case opcodet::CAST_SIGNED:
+      if(i.width<64)
+      {
+        const std::uint64_t mask=(std::uint64_t(1)<<i.width)-1;
+        const std::uint64_t sign=std::uint64_t(1)<<(i.width-1);
+        const std::uint64_t bits=static_cast<std::uint64_t>(a)&mask;
+        r[i.dest]=(bits&sign) ?
+          -static_cast<valuet>(((~bits)&mask)+1) :
+          static_cast<valuet>(bits);
+      }
+      else
+        r[i.dest]=a;
+      break;
+
+    case opcodet::CAST_UNSIGNED:
+      if(i.width<64)
+        r[i.dest]=static_cast<valuet>(
+          static_cast<std::uint64_t>(a)&((std::uint64_t(1)<<i.width)-1));
+      else if(a<0)
+        return true;
+      else
+        r[i.dest]=a;
+      break;
+
+    case opcodet::CAST_BOOL:
+      r[i.dest]=(a!=0);
+      break;
+
+    case opcodet::JUMP:
+      pc=static_cast<std::size_t>(i.constant)-1;
+      break;
+
+    case opcodet::JUMP_IF_ZERO:
+      if(a==0)
+        pc=static_cast<std::size_t>(i.constant)-1;
+      break;
+
+    case opcodet::JUMP_IF_NONZERO:
+      if(a!=0)
+        pc=static_cast<std::size_t>(i.constant)-1;
+      break;
+    }
+  }
+
+  value=r[result];
+  return false;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: Register bytecode for the GOTO interpreter
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Register bytecode for the GOTO interpreter
+///
+/// Side-effect free scalar expressions are lowered once into a flat
+/// sequence of register instructions over native 64-bit integers.
+/// Execution reports failure whenever the result would not agree with
+/// the `mp_integer` evaluation of `interpretert::evaluate` (overflow,
+/// division by zero, a value outside the 64-bit range, ...), in which
+/// case the caller falls back to the generic evaluator.
+
+#ifndef CPROVER_GOTO_PROGRAMS_INTERPRETER_BYTECODE_H
+#define CPROVER_GOTO_PROGRAMS_INTERPRETER_BYTECODE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <util/std_expr.h>
+
+class interpreter_bytecodet
+{
+public:
+  typedef std::int64_t valuet;
+
+  enum class opcodet : unsigned char
+  {
+    CONSTANT,     // dest:=constant
+    LOAD,         // dest:=value of symbols[constant]
+    ADD, SUB, MUL, DIV, NEG,
+    BITAND, BITOR, BITXOR,
+    SHL, LSHR,
+    EQUAL, NOTEQUAL, LT, LE, GT, GE,
+    NOT,
+    CAST_SIGNED,  // dest:=op0 sign-extended from width bits
+    CAST_UNSIGNED, // dest:=op0 truncated to width bits
+    CAST_BOOL,    // dest:=op0!=0
+    JUMP,         // continue at instruction constant
+    JUMP_IF_ZERO, // continue at instruction constant if op0==0
+    JUMP_IF_NONZERO // continue at instruction constant if op0!=0
+  };
+
+  struct instructiont
+  {
+    opcodet opcode;
+    std::size_t width;
+    std::size_t dest, op0, op1;
+    valuet constant;
+  };
+
+  typedef std::vector<instructiont> instructionst;
+
+  /// Callback reading the current value of a symbol; returns true if the
+  /// value is not available as a single 64-bit integer.
+  typedef std::function<bool(const symbol_exprt &, valuet &)> loadert;
+
+  interpreter_bytecodet():
+    number_of_registers(0),
+    result(0)
+  {
+  }
+
+  /// Lowers `expr` into this program.
+  /// \return true if `expr` (or a sub-expression) is not supported, in
+  ///   which case the program is left empty
+  bool compile(const exprt &expr);
+
+  /// Runs the program.
+  /// \param load: reads symbol values
+  /// \param registers: scratch storage, resized as needed
+  /// \param [out] value: the value of the compiled expression
+  /// \return true if the fast path does not apply to this evaluation
+  bool execute(
+    const loadert &load,
+    std::vector<valuet> &registers,
+    valuet &value) const;
+
+  bool empty() const
+  {
+    return instructions.empty();
+  }
+
+  const instructionst &get_instructions() const
+  {
+    return instructions;
+  }
+
+protected:
+  instructionst instructions;
+  std::vector<symbol_exprt> symbols;
+  std::size_t number_of_registers;
+  std::size_t result;
+
+  static bool supported_type(const typet &type);
+
+  bool compile_rec(const exprt &expr, std::size_t dest);
+
+  std::size_t new_register()
+  {
+    return number_of_registers++;
+  }
+
+  /// \return index of the emitted instruction
+  std::size_t emit(
+    opcodet opcode,
+    std::size_t dest,
+    std::size_t op0=0,
+    std::size_t op1=0,
+    valuet constant=0,
+    std::size_t width=0);
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_INTERPRETER_BYTECODE_H
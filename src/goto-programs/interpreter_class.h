@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "goto_functions.h"
 #include "goto_trace.h"
+#include "interpreter_bytecode.h"
 #include "json_goto_trace.h"
 
 class interpretert:public messaget
@@ -40,6 +41,11 @@ public:
     stop_on_assertion(false)
   {
     show=true;
+    load_symbol=
+      [this](const symbol_exprt &symbol, interpreter_bytecodet::valuet &value)
+      {
+        return read_scalar(symbol, value);
+      };
   }
 
   void operator()();
@@ -276,6 +282,10 @@ protected:
 
   bool evaluate_boolean(const exprt &expr)
   {
+    mp_integer value;
+    if(!evaluate_compiled(expr, value))
+      return value!=0;
+
     mp_vectort v;
     evaluate(expr, v);
     if(v.size()!=1)
@@ -301,6 +311,31 @@ protected:
     const exprt &expr,
     mp_vectort &dest);
 
+  // Expressions of the program are lowered to bytecode on first use; the
+  // goto functions are not modified while interpreting, so their addresses
+  // are stable keys. Failed compilations are recorded as empty programs.
+  typedef std::unordered_map<const exprt *, interpreter_bytecodet>
+    compiled_exprst;
+  compiled_exprst compiled_exprs;
+  std::vector<interpreter_bytecodet::valuet> registers;
+  interpreter_bytecodet::loadert load_symbol;
+
+  bool evaluate_compiled(const exprt &expr, mp_integer &value);
+
+  /// Like `evaluate`, trying the compiled fast path first; `expr` must be
+  /// part of the goto functions.
+  void evaluate_program_expr(const exprt &expr, mp_vectort &dest)
+  {
+    mp_integer value;
+    if(!evaluate_compiled(expr, value))
+      dest.push_back(value);
+    else
+      evaluate(expr, dest);
+  }
+  bool read_scalar(
+    const symbol_exprt &symbol,
+    interpreter_bytecodet::valuet &value);
+
   mp_integer evaluate_address(const exprt &expr, bool fail_quietly=false);
 
   void initialize(bool init);
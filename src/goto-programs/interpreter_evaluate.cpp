@@ -1082,6 +1082,53 @@ void interpretert::evaluate(
           << eom;
 }
 
+/// Evaluate an expression of the program using its compiled bytecode
+/// \param expr: expression of one of the goto functions being interpreted
+/// \param [out] value: the value of `expr`
+/// \return true if the fast path does not apply, in which case `evaluate`
+///   has to be used instead
+bool interpretert::evaluate_compiled(
+  const exprt &expr,
+  mp_integer &value)
+{
+  auto entry=compiled_exprs.insert(
+    std::make_pair(&expr, interpreter_bytecodet()));
+  if(entry.second)
+    entry.first->second.compile(expr);
+
+  const interpreter_bytecodet &bytecode=entry.first->second;
+  if(bytecode.empty())
+    return true;
+
+  interpreter_bytecodet::valuet result;
+  if(bytecode.execute(load_symbol, registers, result))
+    return true;
+
+  value=result;
+  return false;
+}
+
+/// Reads a scalar symbol as done by `evaluate`, for the compiled fast path
+/// \return true if the value does not fit into 64 bits
+bool interpretert::read_scalar(
+  const symbol_exprt &symbol,
+  interpreter_bytecodet::valuet &value)
+{
+  const mp_integer address=evaluate_address(symbol, true);
+  if(address.is_zero() || address>=memory.size())
+    return true;
+
+  const memory_cellt &cell=memory[integer2ulong(address)];
+  if(!cell.value.is_long())
+    return true;
+
+  if(cell.initialized==memory_cellt::initializedt::UNKNOWN)
+    cell.initialized=memory_cellt::initializedt::READ_BEFORE_WRITTEN;
+
+  value=cell.value.to_long();
+  return false;
+}
+
 mp_integer interpretert::evaluate_address(
   const exprt &expr,
   bool fail_quietly)
@@ -0,0 +1,212 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Merging of guards via BDDs
+
+#include "bdd_guard_manager.h"
+
+#include <map>
+
+#include <util/std_expr.h>
+
+typedef std::map<std::pair<std::size_t, std::size_t>, mini_bddt>
+  restrict_cachet;
+
+/// The restrict operator of Coudert and Madre
+/// \return a BDD that agrees with \p f wherever \p care holds
+static mini_bddt restrict_to(
+  mini_bdd_mgrt &mgr,
+  const mini_bddt &f,
+  const mini_bddt &care,
+  restrict_cachet &cache)
+{
+  // nothing is cared about if care is false
+  if(f.is_constant() || care.is_constant())
+    return f;
+  else if(f.node==care.node)
+    return mgr.True();
+
+  const std::pair<std::size_t, std::size_t> key(
+    f.node->unique_id, care.node->unique_id);
+
+  restrict_cachet::const_iterator entry=cache.find(key);
+  if(entry!=cache.end())
+    return entry->second;
+
+  mini_bddt result;
+
+  if(care.var()<f.var())
+    result=restrict_to(mgr, f, care.low()|care.high(), cache);
+  else if(care.var()>f.var())
+    result=
+      mgr.mk(
+        f.var(),
+        restrict_to(mgr, f.low(), care, cache),
+        restrict_to(mgr, f.high(), care, cache));
+  else if(care.low().is_false())
+    result=restrict_to(mgr, f.high(), care.high(), cache);
+  else if(care.high().is_false())
+    result=restrict_to(mgr, f.low(), care.low(), cache);
+  else
+    result=
+      mgr.mk(
+        f.var(),
+        restrict_to(mgr, f.low(), care.low(), cache),
+        restrict_to(mgr, f.high(), care.high(), cache));
+
+  cache[key]=result;
+
+  return result;
+}
+
+mini_bddt bdd_guard_managert::from_expr(const exprt &expr)
+{
+  if(expr.is_true())
+    return bdd_mgr.True();
+  else if(expr.is_false())
+    return bdd_mgr.False();
+
+  // guards share subterms, e.g., the conditions merged by phi functions;
+  // translating them once per occurrence would take exponential time
+  node_cachet::const_iterator cached=guard_bdds.find(&expr.read());
+  if(cached!=guard_bdds.end())
+    return cached->second.second;
+
+  mini_bddt result;
+
+  if(expr.id()==ID_not && expr.operands().size()==1)
+    result=!from_expr(expr.op0());
+  else if((expr.id()==ID_and || expr.id()==ID_or) &&
+          !expr.operands().empty())
+  {
+    result=from_expr(expr.op0());
+
+    for(exprt::operandst::const_iterator it=++expr.operands().begin();
+        it!=expr.operands().end();
+        ++it)
+    {
+      mini_bddt op=from_expr(*it);
+      result=expr.id()==ID_and ? (result&op) : (result|op);
+    }
+  }
+  else if(expr.id()==ID_if && expr.type().id()==ID_bool)
+  {
+    const if_exprt &if_expr=to_if_expr(expr);
+    mini_bddt cond=from_expr(if_expr.cond());
+
+    result=(cond&from_expr(if_expr.true_case())) |
+           ((!cond)&from_expr(if_expr.false_case()));
+  }
+  else
+  {
+    std::pair<bdd_cachet::iterator, bool> entry=
+      atom_bdds.insert(std::make_pair(expr, mini_bddt()));
+
+    if(entry.second)
+    {
+      atoms.push_back(expr);
+      entry.first->second=bdd_mgr.Var(std::to_string(atoms.size()));
+    }
+
+    result=entry.first->second;
+  }
+
+  if(guard_bdds.size()>=cache_limit)
+    guard_bdds.clear();
+
+  guard_bdds[&expr.read()]=std::make_pair(expr, result);
+
+  return result;
+}
+
+exprt bdd_guard_managert::as_expr(const mini_bddt &bdd)
+{
+  if(bdd.is_true())
+    return true_exprt();
+  else if(bdd.is_false())
+    return false_exprt();
+
+  expr_cachet::const_iterator entry=guard_exprs.find(bdd.node->unique_id);
+  if(entry!=guard_exprs.end())
+    return entry->second;
+
+  // collect the literals that hold on all paths to true
+  exprt::operandst conjuncts;
+  mini_bddt node=bdd;
+
+  while(!node.is_constant())
+  {
+    const exprt &atom=atoms[node.var()-1];
+    mini_bddt next;
+
+    if(node.low().is_false())
+    {
+      conjuncts.push_back(atom);
+      next=node.high();
+    }
+    else if(node.high().is_false())
+    {
+      conjuncts.push_back(not_exprt(atom));
+      next=node.low();
+    }
+    else
+    {
+      if(node.low().is_true())
+        conjuncts.push_back(or_exprt(not_exprt(atom), as_expr(node.high())));
+      else if(node.high().is_true())
+        conjuncts.push_back(or_exprt(atom, as_expr(node.low())));
+      else
+        conjuncts.push_back(
+          if_exprt(atom, as_expr(node.high()), as_expr(node.low())));
+      break;
+    }
+
+    node=next;
+  }
+
+  if(guard_exprs.size()>=cache_limit)
+    guard_exprs.clear();
+
+  exprt result=conjunction(conjuncts);
+  guard_exprs[bdd.node->unique_id]=result;
+
+  return result;
+}
+
+guardt bdd_guard_managert::disjunction(const guardt &g1, const guardt &g2)
+{
+  guardt result;
+
+  if(g1.is_true() || g2.is_false())
+    result=g1;
+  else if(g2.is_true() || g1.is_false())
+    result=g2;
+  else
+    result=as_expr(from_expr(g1)|from_expr(g2));
+
+  return result;
+}
+
+guardt bdd_guard_managert::difference(
+  const guardt &guard,
+  const guardt &other)
+{
+  if(guard.is_true() || guard.is_false() || other.is_false())
+    return guard;
+
+  const mini_bddt guard_bdd=from_expr(guard);
+  const mini_bddt care=guard_bdd|from_expr(other);
+
+  restrict_cachet cache;
+
+  guardt result;
+  result=as_expr(restrict_to(bdd_mgr, guard_bdd, care, cache));
+
+  return result;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Merging of guards via BDDs
+///
+/// Merging the guards of the branches that join at a control-flow merge
+/// point syntactically produces ever-growing disjunctions. Instead, the
+/// guards are translated into BDDs whose variables are the atoms of the
+/// guards (the guard symbols introduced by symex_goto), merged there,
+/// and translated back. The result is canonical: guards that are
+/// equivalent are translated to the same expression, and a branch that
+/// is fully joined again yields the guard before the branch. Guards that
+/// are conjunctions of literals are returned as flat conjunctions, as
+/// guardt produces them.
+
+#ifndef CPROVER_GOTO_SYMEX_BDD_GUARD_MANAGER_H
+#define CPROVER_GOTO_SYMEX_BDD_GUARD_MANAGER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <util/guard.h>
+
+#include <solvers/miniBDD/miniBDD.h>
+
+class bdd_guard_managert
+{
+public:
+  /// \return a guard equivalent to the disjunction of \p g1 and \p g2
+  guardt disjunction(const guardt &g1, const guardt &g2);
+
+  /// \return a guard that is equivalent to \p guard whenever \p guard or
+  ///   \p other holds, and that is simpler than \p guard where possible
+  guardt difference(const guardt &guard, const guardt &other);
+
+protected:
+  mini_bdd_mgrt bdd_mgr;
+
+  // the atoms, indexed by their BDD variable minus one
+  std::vector<exprt> atoms;
+
+  typedef std::unordered_map<exprt, mini_bddt, irep_hash> bdd_cachet;
+  bdd_cachet atom_bdds;
+
+  // the BDDs of guards and their subterms, by their shared node; the
+  // expression is kept to keep the node alive
+  typedef std::unordered_map<
+    const irept::dt *, std::pair<exprt, mini_bddt>> node_cachet;
+  node_cachet guard_bdds;
+
+  // the expressions of BDD nodes, by their unique id
+  typedef std::unordered_map<std::size_t, exprt> expr_cachet;
+  expr_cachet guard_exprs;
+
+  // guard_bdds and guard_exprs are flushed when growing beyond this size;
+  // atom_bdds and the BDD manager are kept, as the BDDs refer to them
+  static const std::size_t cache_limit=1<<16;
+
+  mini_bddt from_expr(const exprt &expr);
+  exprt as_expr(const mini_bddt &bdd);
+};
+
+#endif // CPROVER_GOTO_SYMEX_BDD_GUARD_MANAGER_H
@@ -109,6 +109,22 @@ exprt adjust_lhs_object(
   return nil_exprt();
 }
 
+bool has_dynamic_object(const exprt &expr, const namespacet &ns)
+{
+  if(expr.id()==ID_symbol)
+  {
+    const irep_idt &id=to_ssa_expr(expr).get_original_name();
+    const symbolt *symbol;
+    return !ns.lookup(id, symbol) && symbol->type.get_bool("#dynamic");
+  }
+
+  forall_operands(it, expr)
+    if(has_dynamic_object(*it, ns))
+      return true;
+
+  return false;
+}
+
 /// set internal field for variable assignment related to dynamic_object[0-9]
 /// and dynamic_[0-9]_array.
 void set_internal_dynamic_object(
@@ -116,22 +132,8 @@ void set_internal_dynamic_object(
   goto_trace_stept &goto_trace_step,
   const namespacet &ns)
 {
-  if(expr.id()==ID_symbol)
-  {
-    const irep_idt &id=to_ssa_expr(expr).get_original_name();
-    const symbolt *symbol;
-    if(!ns.lookup(id, symbol))
-    {
-      bool result=symbol->type.get_bool("#dynamic");
-      if(result)
-        goto_trace_step.internal=true;
-    }
-  }
-  else
-  {
-    forall_operands(it, expr)
-      set_internal_dynamic_object(*it, goto_trace_step, ns);
-  }
+  if(has_dynamic_object(expr, ns))
+    goto_trace_step.internal=true;
 }
 
 /// set internal for variables assignments related to dynamic_object and CPROVER
@@ -141,9 +143,12 @@ void update_internal_field(
   goto_trace_stept &goto_trace_step,
   const namespacet &ns)
 {
-  // set internal for dynamic_object in both lhs and rhs expressions
+  // set internal for dynamic_object in both lhs and rhs expressions; the
+  // rhs may have been dropped already
   set_internal_dynamic_object(SSA_step.ssa_lhs, goto_trace_step, ns);
   set_internal_dynamic_object(SSA_step.ssa_rhs, goto_trace_step, ns);
+  if(SSA_step.dynamic_object)
+    goto_trace_step.internal=true;
 
   // set internal field to CPROVER functions (e.g., __CPROVER_initialize)
   if(SSA_step.is_function_call())
@@ -289,17 +294,23 @@ void build_goto_trace(
       goto_trace_stept::assignment_typet::ACTUAL_PARAMETER:
       goto_trace_stept::assignment_typet::STATE;
 
+    // streamed steps drop ssa_full_lhs where it is just ssa_lhs
+    const exprt &ssa_full_lhs=
+      SSA_step.ssa_full_lhs.is_nil() &&
+      (SSA_step.is_assignment() || SSA_step.is_decl())?
+      SSA_step.ssa_lhs:SSA_step.ssa_full_lhs;
+
     if(SSA_step.original_full_lhs.is_not_nil())
       goto_trace_step.full_lhs=
         build_full_lhs_rec(
-          prop_conv, ns, SSA_step.original_full_lhs, SSA_step.ssa_full_lhs);
+          prop_conv, ns, SSA_step.original_full_lhs, ssa_full_lhs);
 
     if(SSA_step.ssa_lhs.is_not_nil())
       goto_trace_step.lhs_object_value=prop_conv.get(SSA_step.ssa_lhs);
 
-    if(SSA_step.ssa_full_lhs.is_not_nil())
+    if(ssa_full_lhs.is_not_nil())
     {
-      goto_trace_step.full_lhs_value=prop_conv.get(SSA_step.ssa_full_lhs);
+      goto_trace_step.full_lhs_value=prop_conv.get(ssa_full_lhs);
       simplify(goto_trace_step.full_lhs_value, ns);
     }
 
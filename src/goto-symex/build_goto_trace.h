@@ -17,6 +17,10 @@ Date: July 2005
 #include "symex_target_equation.h"
 #include "goto_symex_state.h"
 
+/// \return true if \p expr mentions a dynamic object, whose steps are
+///   internal to traces
+bool has_dynamic_object(const exprt &expr, const namespacet &ns);
+
 // builds a trace that stops at first failing assertion
 void build_goto_trace(
   const symex_target_equationt &target,
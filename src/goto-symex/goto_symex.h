@@ -12,11 +12,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 #define CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include <util/options.h>
 #include <util/byte_operators.h>
 
 #include <goto-programs/goto_functions.h>
 
+#include "bdd_guard_manager.h"
 #include "goto_symex_state.h"
 
 class typet;
@@ -47,6 +51,7 @@ public:
     symex_targett &_target):
     total_vccs(0),
     remaining_vccs(0),
+    reused_function_calls(0),
     constant_propagation(true),
     new_symbol_table(_new_symbol_table),
     language_mode(),
@@ -90,6 +95,7 @@ public:
 
   // statistics
   unsigned total_vccs, remaining_vccs;
+  unsigned reused_function_calls;
 
   bool constant_propagation;
 
@@ -100,6 +106,10 @@ public:
   /// if we know the source language in use, irep_idt() otherwise.
   irep_idt language_mode;
 
+  /// Location numbers of assignments and gotos that no property depends
+  /// on; these are executed as skips.
+  std::unordered_set<unsigned> irrelevant_instructions;
+
 protected:
   const namespacet &ns;
   symex_targett &target;
@@ -151,6 +161,9 @@ protected:
 
   irep_idt guard_identifier;
 
+  // merges guards if the option bdd-guards is set
+  bdd_guard_managert bdd_guard_manager;
+
   // symex
   virtual void symex_transition(
     statet &state,
@@ -251,6 +264,48 @@ protected:
     exprt &code,
     const irep_idt &identifier);
 
+  // function summaries, see symex_function_summary.cpp
+
+  struct summary_infot
+  {
+    bool summarizable;
+    // the non-local variables read by the function and its callees
+    std::set<irep_idt> globals_read;
+  };
+
+  typedef std::map<irep_idt, summary_infot> summary_infost;
+  summary_infost summary_infos;
+
+  struct function_summaryt
+  {
+    guardt guard;
+    exprt return_value;
+  };
+
+  typedef std::unordered_map<exprt, function_summaryt, irep_hash>
+    function_summariest;
+  function_summariest function_summaries;
+
+  const summary_infot &get_summary_info(
+    const goto_functionst &goto_functions,
+    const irep_idt &identifier);
+
+  exprt function_summary_key(
+    const goto_functionst &goto_functions,
+    statet &state,
+    const irep_idt &identifier,
+    const exprt::operandst &arguments);
+
+  bool reuse_function_summary(
+    statet &state,
+    const irep_idt &identifier,
+    const exprt &key);
+
+  void record_function_summary(
+    statet &state,
+    const exprt &key,
+    const guardt &guard);
+
   // exceptions
 
   void symex_throw(statet &state);
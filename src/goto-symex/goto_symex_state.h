@@ -186,6 +186,11 @@ public:
   // do dereferencing
   value_sett value_set;
 
+  // results of dereferencing, keyed on the L1 pointer, the access mode and
+  // the objects the pointer may point to, see goto_symext::dereference_rec
+  typedef std::unordered_map<exprt, exprt, irep_hash> dereference_cachet;
+  dereference_cachet dereference_cache;
+
   class goto_statet
   {
   public:
@@ -251,9 +256,14 @@ public:
     typedef std::set<irep_idt> local_objectst;
     local_objectst local_objects;
 
+    // the inputs and the guard of the call, if its summary is recorded
+    exprt summary_key;
+    guardt summary_guard;
+
     framet():
       return_value(nil_exprt()),
-      hidden_function(false)
+      hidden_function(false),
+      summary_key(nil_exprt())
     {
     }
 
@@ -342,7 +352,8 @@ public:
 
   void switch_to_thread(unsigned t);
   bool record_events;
-  std::unique_ptr<const dirtyt> dirty;
+  // shared with copies of this state, which keep it alive
+  std::shared_ptr<const dirtyt> dirty;
 };
 
 #endif // CPROVER_GOTO_SYMEX_GOTO_SYMEX_STATE_H
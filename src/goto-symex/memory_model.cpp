@@ -66,6 +66,22 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       exprt::operandst rf_some_operands;
       rf_some_operands.reserve(a_rec.writes.size());
 
+      // A read cannot observe a write of its own thread that is
+      // followed, in program order and before the read, by an
+      // unconditional write to the same address: all our memory
+      // models keep the writes of one thread to one address in order.
+      event_it last_unconditional=equation.SSA_steps.end();
+
+      for(const auto &w : a_rec.writes)
+      {
+        if(w->source.thread_nr==r->source.thread_nr &&
+           w->guard.is_true() &&
+           po(w, r) &&
+           (last_unconditional==equation.SSA_steps.end() ||
+            po(last_unconditional, w)))
+          last_unconditional=w;
+      }
+
       // this is quadratic in #events per address
       for(event_listt::const_iterator
           w_it=a_rec.writes.begin();
@@ -78,14 +94,18 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
         if(po(r, w))
           continue; // contradicts po
 
+        // overwritten before the read
+        if(last_unconditional!=equation.SSA_steps.end() &&
+           po(w, last_unconditional))
+          continue;
+
         bool is_rfi=
           w->source.thread_nr==r->source.thread_nr;
 
         symbol_exprt s=nondet_bool_symbol("rf");
 
         // record the symbol
-        choice_symbols[
-          std::make_pair(r, w)]=s;
+        choice_symbols[w].push_back(std::make_pair(r, s));
 
         // We rely on the fact that there is at least
         // one write event that has guard 'true'.
@@ -30,10 +30,11 @@ protected:
   unsigned var_cnt;
   symbol_exprt nondet_bool_symbol(const std::string &prefix);
 
-  // This gives us the choice symbol for an R-W pair;
+  // This gives us, for each write, the reads that may read from it
+  // together with the choice symbol of the R-W pair;
   // built by the method below.
-  typedef std::map<
-    std::pair<event_it, event_it>, symbol_exprt> choice_symbolst;
+  typedef std::vector<std::pair<event_it, symbol_exprt>> rf_choicest;
+  typedef std::map<event_it, rf_choicest> choice_symbolst;
   choice_symbolst choice_symbols;
 
   void read_from(symex_target_equationt &equation);
@@ -289,45 +289,53 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
           ws2=before(*w, *w_prime);
         }
 
-        // smells like cubic
-        for(choice_symbolst::const_iterator
-            c_it=choice_symbols.begin();
-            c_it!=choice_symbols.end();
-            c_it++)
+        // only the reads that may read from w_prime or w are affected
+        if(!ws1.is_false())
         {
-          event_it r=c_it->first.first;
-          exprt rf=c_it->second;
-          exprt cond;
-          cond.make_nil();
-
-          if(c_it->first.second==*w_prime && !ws1.is_false())
+          choice_symbolst::const_iterator c_it=choice_symbols.find(*w_prime);
+          if(c_it!=choice_symbols.end())
           {
-            exprt fr=before(r, *w);
-
-            // the guard of w_prime follows from rf; with rfi
-            // optimisation such as the previous write_symbol_primed
-            // it would even be wrong to add this guard
-            cond=
-              implies_exprt(
-                and_exprt(r->guard, (*w)->guard, ws1, rf),
-                fr);
+            for(const auto &r_rf : c_it->second)
+            {
+              event_it r=r_rf.first;
+              exprt fr=before(r, *w);
+
+              // the guard of w_prime follows from rf; with rfi
+              // optimisation such as the previous write_symbol_primed
+              // it would even be wrong to add this guard
+              add_constraint(
+                equation,
+                implies_exprt(
+                  and_exprt(r->guard, (*w)->guard, ws1, r_rf.second),
+                  fr),
+                "fr",
+                r->source);
+            }
           }
-          else if(c_it->first.second==*w && !ws2.is_false())
+        }
+
+        if(!ws2.is_false())
+        {
+          choice_symbolst::const_iterator c_it=choice_symbols.find(*w);
+          if(c_it!=choice_symbols.end())
           {
-            exprt fr=before(r, *w_prime);
-
-            // the guard of w follows from rf; with rfi
-            // optimisation such as the previous write_symbol_primed
-            // it would even be wrong to add this guard
-            cond=
-              implies_exprt(
-                and_exprt(r->guard, (*w_prime)->guard, ws2, rf),
-                fr);
+            for(const auto &r_rf : c_it->second)
+            {
+              event_it r=r_rf.first;
+              exprt fr=before(r, *w_prime);
+
+              // the guard of w follows from rf; with rfi
+              // optimisation such as the previous write_symbol_primed
+              // it would even be wrong to add this guard
+              add_constraint(
+                equation,
+                implies_exprt(
+                  and_exprt(r->guard, (*w_prime)->guard, ws2, r_rf.second),
+                  fr),
+                "fr",
+                r->source);
+            }
           }
-
-          if(cond.is_not_nil())
-            add_constraint(equation,
-              cond, "fr", r->source);
         }
       }
     }
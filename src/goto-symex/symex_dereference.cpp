@@ -245,9 +245,40 @@ void goto_symext::dereference_rec(
     // first make sure there are no dereferences in there
     dereference_rec(tmp1, state, guard, false);
 
+    // The result only depends on the pointer, the access mode and the
+    // objects the pointer may point to: the guard is merely passed on to
+    // dereference_failure, which symex ignores. Pointers that are ifs are
+    // split by value_set_dereferencet and queried case by case, hence
+    // their combined value set is no suitable key.
+    value_setst::valuest points_to_set;
+    exprt cache_key=nil_exprt();
+
+    if(tmp1.id()!=ID_if)
+    {
+      state.value_set.get_value_set(tmp1, points_to_set, ns);
+
+      cache_key=exprt(write?ID_write:ID_read);
+      cache_key.copy_to_operands(tmp1);
+      for(const auto &object : points_to_set)
+        cache_key.copy_to_operands(object);
+
+      statet::dereference_cachet::const_iterator cache_entry=
+        state.dereference_cache.find(cache_key);
+
+      if(cache_entry!=state.dereference_cache.end())
+      {
+        expr=cache_entry->second;
+        trigger_auto_object(expr, state);
+        return;
+      }
+    }
+
     // we need to set up some elaborate call-backs
     symex_dereference_statet symex_dereference_state(*this, state);
 
+    if(cache_key.is_not_nil())
+      symex_dereference_state.set_known_value_set(tmp1, points_to_set);
+
     value_set_dereferencet dereference(
       ns,
       new_symbol_table,
@@ -265,6 +296,9 @@ void goto_symext::dereference_rec(
           value_set_dereferencet::modet::READ);
     // std::cout << "**** " << from_expr(ns, "", tmp2) << '\n';
 
+    if(cache_key.is_not_nil())
+      state.dereference_cache.insert(std::make_pair(cache_key, tmp2));
+
     expr.swap(tmp2);
 
     // this may yield a new auto-object
@@ -81,6 +81,13 @@ void symex_dereference_statet::get_value_set(
   const exprt &expr,
   value_setst::valuest &value_set)
 {
+  if(known_pointer!=nullptr && expr==*known_pointer)
+  {
+    value_set.insert(
+      value_set.end(), known_value_set->begin(), known_value_set->end());
+    return;
+  }
+
   state.value_set.get_value_set(expr, value_set, goto_symex.ns);
 
   #if 0
@@ -24,13 +24,27 @@ public:
     goto_symext &_goto_symex,
     goto_symext::statet &_state):
     goto_symex(_goto_symex),
-    state(_state)
+    state(_state),
+    known_pointer(nullptr),
+    known_value_set(nullptr)
   {
   }
 
+  /// Answer value-set queries for \p pointer with \p value_set, which the
+  /// caller has already computed; both must outlive this object
+  void set_known_value_set(
+    const exprt &pointer,
+    const value_setst::valuest &value_set)
+  {
+    known_pointer=&pointer;
+    known_value_set=&value_set;
+  }
+
 protected:
   goto_symext &goto_symex;
   goto_symext::statet &state;
+  const exprt *known_pointer;
+  const value_setst::valuest *known_value_set;
 
   virtual void dereference_failure(
     const std::string &property,
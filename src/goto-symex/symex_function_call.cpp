@@ -258,14 +258,12 @@ void goto_symext::symex_function_call_code(
     return;
   }
 
-  // record the call
-  target.function_call(state.guard.as_expr(), identifier, state.source);
-
   if(!goto_function.body_available())
   {
     no_body(identifier);
 
-    // record the return
+    // record the call and the return
+    target.function_call(state.guard.as_expr(), identifier, state.source);
     target.function_return(state.guard.as_expr(), identifier, state.source);
 
     if(call.lhs().is_not_nil())
@@ -285,6 +283,26 @@ void goto_symext::symex_function_call_code(
   for(auto &a : arguments)
     state.rename(a, ns);
 
+  // calls with the same inputs as an earlier one need not be executed
+  exprt summary_key=nil_exprt();
+  if(options.get_bool_option("symex-summaries") &&
+     call.lhs().is_nil() &&
+     state.threads.size()==1)
+  {
+    summary_key=
+      function_summary_key(goto_functions, state, identifier, arguments);
+
+    if(summary_key.is_not_nil() &&
+       reuse_function_summary(state, identifier, summary_key))
+    {
+      symex_transition(state);
+      return;
+    }
+  }
+
+  // record the call
+  target.function_call(state.guard.as_expr(), identifier, state.source);
+
   // produce a new frame
   assert(!state.call_stack().empty());
   goto_symex_statet::framet &frame=state.new_frame();
@@ -300,6 +318,8 @@ void goto_symext::symex_function_call_code(
   frame.calling_location=state.source;
   frame.function_identifier=identifier;
   frame.hidden_function=goto_function.is_hidden();
+  frame.summary_key=summary_key;
+  frame.summary_guard=state.guard;
 
   const goto_symex_statet::framet &p_frame=state.previous_frame();
   for(goto_symex_statet::framet::loop_iterationst::const_iterator
@@ -364,8 +384,16 @@ void goto_symext::symex_end_of_function(statet &state)
   target.function_return(
     state.guard.as_expr(), state.source.pc->function, state.source);
 
+  exprt summary_key;
+  guardt summary_guard;
+  summary_key.swap(state.top().summary_key);
+  summary_guard.swap(state.top().summary_guard);
+
   // then get rid of the frame
   pop_frame(state);
+
+  if(summary_key.is_not_nil())
+    record_function_summary(state, summary_key, summary_guard);
 }
 
 /// preserves locality of local variables of a given function by applying L1
@@ -0,0 +1,362 @@
+/*******************************************************************\
+
+Module: Symbolic Execution of ANSI-C
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reuse of the results of earlier function calls
+///
+/// A function is summarizable if its only effect is the assignment to its
+/// return value, i.e., it writes local variables only, does not
+/// dereference pointers and does not introduce nondeterminism. The value
+/// of a call is then determined by the (L2-renamed) arguments and the
+/// globals the function reads. The SSA equations of a call hold
+/// unconditionally, so the value of an earlier call with the same inputs
+/// applies whenever the guard of that call does, and that is the case if
+/// the guard of the new call contains all of its conjuncts. Assertions
+/// and assumptions in the callee have then been added for these inputs
+/// already. Reading a local variable before assigning it introduces
+/// nondeterminism, too.
+
+#include "goto_symex.h"
+
+#include <map>
+#include <unordered_set>
+
+#include <util/cprover_prefix.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/prefix.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/remove_returns.h>
+
+typedef std::unordered_set<exprt, irep_hash> conjunctst;
+
+static void get_conjuncts(const guardt &guard, conjunctst &dest)
+{
+  if(guard.is_true())
+    return;
+  else if(guard.id()==ID_and)
+    dest.insert(guard.operands().begin(), guard.operands().end());
+  else
+    dest.insert(guard);
+}
+
+/// \return true if each conjunct of \p implied is one of \p guard
+static bool guard_implies(const guardt &guard, const guardt &implied)
+{
+  conjunctst conjuncts;
+  get_conjuncts(guard, conjuncts);
+
+  if(implied.is_true())
+    return true;
+  else if(implied.id()!=ID_and)
+    return conjuncts.find(implied)!=conjuncts.end();
+
+  forall_operands(it, implied)
+    if(conjuncts.find(*it)==conjuncts.end())
+      return false;
+
+  return true;
+}
+
+static bool has_pointer_type(const typet &type, const namespacet &ns)
+{
+  const typet &followed=ns.follow(type);
+
+  if(followed.id()==ID_pointer)
+    return true;
+  else if(followed.id()==ID_struct || followed.id()==ID_union)
+  {
+    for(const auto &component : to_struct_union_type(followed).components())
+      if(has_pointer_type(component.type(), ns))
+        return true;
+  }
+  else if(followed.id()==ID_array || followed.id()==ID_vector)
+    return has_pointer_type(followed.subtype(), ns);
+
+  return false;
+}
+
+/// \return true if a declared variable may be read before it is assigned,
+///   which yields a fresh nondeterministic value on each call
+static bool may_read_uninitialized(const goto_programt &goto_program)
+{
+  // the variables that may be uninitialized before each instruction
+  typedef std::set<irep_idt> uninitializedt;
+  std::map<goto_programt::const_targett, uninitializedt> states;
+  std::set<goto_programt::const_targett> work;
+
+  if(goto_program.instructions.empty())
+    return false;
+
+  states[goto_program.instructions.begin()];
+  work.insert(goto_program.instructions.begin());
+
+  while(!work.empty())
+  {
+    const goto_programt::const_targett it=*work.begin();
+    work.erase(work.begin());
+
+    uninitializedt uninitialized=states[it];
+
+    find_symbols_sett read;
+    find_symbols(it->guard, read);
+
+    if(it->is_assign())
+      find_symbols(to_code_assign(it->code).rhs(), read);
+    else if(!it->is_decl() && !it->is_dead())
+      find_symbols(it->code, read);
+
+    for(const auto &identifier : read)
+      if(uninitialized.find(identifier)!=uninitialized.end())
+        return true;
+
+    if(it->is_decl())
+      uninitialized.insert(to_code_decl(it->code).get_identifier());
+    else if(it->is_dead())
+      uninitialized.erase(to_code_dead(it->code).get_identifier());
+    else if(it->is_assign())
+      uninitialized.erase(
+        to_symbol_expr(to_code_assign(it->code).lhs()).get_identifier());
+
+    for(const auto &successor : goto_program.get_successors(it))
+    {
+      const auto entry=states.insert(
+        std::make_pair(successor, uninitializedt()));
+      uninitializedt &state=entry.first->second;
+      const std::size_t size=state.size();
+      state.insert(uninitialized.begin(), uninitialized.end());
+
+      if(entry.second || state.size()!=size)
+        work.insert(successor);
+    }
+  }
+
+  return false;
+}
+
+const goto_symext::summary_infot &goto_symext::get_summary_info(
+  const goto_functionst &goto_functions,
+  const irep_idt &identifier)
+{
+  summary_infost::const_iterator entry=summary_infos.find(identifier);
+  if(entry!=summary_infos.end())
+    return entry->second;
+
+  // not summarizable while it is being analysed, which excludes recursion
+  summary_infot &info=summary_infos[identifier];
+  info.summarizable=false;
+
+  goto_functionst::function_mapt::const_iterator f_it=
+    goto_functions.function_map.find(identifier);
+
+  if(f_it==goto_functions.function_map.end() ||
+     !f_it->second.body_available())
+    return info;
+
+  const goto_functionst::goto_functiont &goto_function=f_it->second;
+
+  for(const auto &parameter : goto_function.type.parameters())
+    if(has_pointer_type(parameter.type(), ns))
+      return info;
+
+  const irep_idt return_value_id=
+    id2string(identifier)+RETURN_VALUE_SUFFIX;
+
+  const symbolt *return_value_symbol;
+  if(!ns.lookup(return_value_id, return_value_symbol) &&
+     has_pointer_type(return_value_symbol->type, ns))
+    return info;
+
+  std::set<irep_idt> local_identifiers;
+  get_local_identifiers(goto_function, local_identifiers);
+
+  // the return values of callees are assigned before they are read
+  std::set<irep_idt> callee_return_values;
+  std::set<irep_idt> globals_read;
+  find_symbols_sett symbols;
+
+  forall_goto_program_instructions(it, goto_function.body)
+  {
+    switch(it->type)
+    {
+    case ASSIGN:
+      {
+        const exprt &lhs=to_code_assign(it->code).lhs();
+        if(lhs.id()!=ID_symbol)
+          return info;
+
+        const irep_idt &lhs_id=to_symbol_expr(lhs).get_identifier();
+        if(lhs_id!=return_value_id &&
+           local_identifiers.find(lhs_id)==local_identifiers.end())
+          return info;
+      }
+      break;
+
+    case FUNCTION_CALL:
+      {
+        const code_function_callt &call=to_code_function_call(it->code);
+        if(call.function().id()!=ID_symbol ||
+           call.lhs().is_not_nil())
+          return info;
+
+        const irep_idt &callee=
+          to_symbol_expr(call.function()).get_identifier();
+        if(callee=="CBMC_trace" ||
+           has_prefix(id2string(callee), CPROVER_FKT_PREFIX) ||
+           has_prefix(id2string(callee), CPROVER_MACRO_PREFIX))
+          return info;
+
+        const summary_infot &callee_info=
+          get_summary_info(goto_functions, callee);
+        if(!callee_info.summarizable)
+          return info;
+
+        globals_read.insert(
+          callee_info.globals_read.begin(),
+          callee_info.globals_read.end());
+        callee_return_values.insert(id2string(callee)+RETURN_VALUE_SUFFIX);
+      }
+      break;
+
+    case OTHER:
+    case START_THREAD:
+    case END_THREAD:
+    case ATOMIC_BEGIN:
+    case ATOMIC_END:
+    case THROW:
+    case CATCH:
+      return info;
+
+    default:
+      break;
+    }
+
+    if(has_subexpr(it->code, ID_dereference) ||
+       has_subexpr(it->code, ID_address_of) ||
+       has_subexpr(it->code, ID_side_effect) ||
+       has_subexpr(it->guard, ID_dereference) ||
+       has_subexpr(it->guard, ID_address_of) ||
+       has_subexpr(it->guard, ID_side_effect))
+      return info;
+
+    find_symbols(it->code, symbols);
+    find_symbols(it->guard, symbols);
+  }
+
+  if(may_read_uninitialized(goto_function.body))
+    return info;
+
+  for(const auto &symbol_id : symbols)
+  {
+    if(symbol_id==return_value_id ||
+       local_identifiers.find(symbol_id)!=local_identifiers.end() ||
+       callee_return_values.find(symbol_id)!=callee_return_values.end())
+      continue;
+
+    const symbolt *symbol;
+    if(ns.lookup(symbol_id, symbol))
+      return info;
+
+    // functions are called, not read
+    if(symbol->type.id()!=ID_code)
+      globals_read.insert(symbol_id);
+  }
+
+  info.summarizable=true;
+  info.globals_read.swap(globals_read);
+
+  return info;
+}
+
+/// \return the inputs of a call to \p identifier with the already renamed
+///   \p arguments, or nil if the function is not summarizable
+exprt goto_symext::function_summary_key(
+  const goto_functionst &goto_functions,
+  statet &state,
+  const irep_idt &identifier,
+  const exprt::operandst &arguments)
+{
+  const summary_infot &info=get_summary_info(goto_functions, identifier);
+
+  if(!info.summarizable)
+    return nil_exprt();
+
+  exprt key(ID_function_call);
+  key.copy_to_operands(symbol_exprt(identifier));
+  key.operands().insert(
+    key.operands().end(), arguments.begin(), arguments.end());
+
+  for(const auto &global : info.globals_read)
+  {
+    exprt value=ns.lookup(global).symbol_expr();
+    state.rename(value, ns);
+    key.move_to_operands(value);
+  }
+
+  return key;
+}
+
+/// Assigns the return value of an earlier call with inputs \p key, if any,
+/// instead of executing the function; the call and the return are recorded
+/// as if the function had been executed.
+/// \return true if the call has been replaced
+bool goto_symext::reuse_function_summary(
+  statet &state,
+  const irep_idt &identifier,
+  const exprt &key)
+{
+  function_summariest::const_iterator entry=function_summaries.find(key);
+
+  if(entry==function_summaries.end() ||
+     !guard_implies(state.guard, entry->second.guard))
+    return false;
+
+  target.function_call(state.guard.as_expr(), identifier, state.source);
+  target.function_return(state.guard.as_expr(), identifier, state.source);
+
+  const function_summaryt &summary=entry->second;
+  if(summary.return_value.is_not_nil())
+  {
+    const symbolt &return_value_symbol=
+      ns.lookup(id2string(identifier)+RETURN_VALUE_SUFFIX);
+    symex_assign_rec(
+      state,
+      code_assignt(return_value_symbol.symbol_expr(), summary.return_value));
+  }
+
+  ++reused_function_calls;
+
+  return true;
+}
+
+/// Records the return value of the call with inputs \p key that has just
+/// returned, if it returned on all the paths that entered it under \p guard.
+void goto_symext::record_function_summary(
+  statet &state,
+  const exprt &key,
+  const guardt &guard)
+{
+  if(!guard_implies(guard, state.guard))
+    return;
+
+  function_summaryt &summary=function_summaries[key];
+  summary.guard=guard;
+
+  const irep_idt &identifier=to_symbol_expr(key.op0()).get_identifier();
+  const symbolt *return_value_symbol;
+
+  if(ns.lookup(
+       id2string(identifier)+RETURN_VALUE_SUFFIX, return_value_symbol))
+    summary.return_value.make_nil();
+  else
+  {
+    summary.return_value=return_value_symbol->symbol_expr();
+    state.rename(summary.return_value, ns);
+  }
+}
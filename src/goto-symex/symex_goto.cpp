@@ -245,7 +245,10 @@ void goto_symext::merge_goto(
   merge_value_sets(goto_state, state);
 
   // adjust guard
-  state.guard|=goto_state.guard;
+  if(options.get_bool_option("bdd-guards"))
+    state.guard=bdd_guard_manager.disjunction(state.guard, goto_state.guard);
+  else
+    state.guard|=goto_state.guard;
 
   // adjust depth
   state.depth=std::min(state.depth, goto_state.depth);
@@ -278,10 +281,15 @@ void goto_symext::phi_function(
 
   if(!variables.empty())
   {
-    diff_guard=goto_state.guard;
-
     // this gets the diff between the guards
-    diff_guard-=dest_state.guard;
+    if(options.get_bool_option("bdd-guards"))
+      diff_guard=
+        bdd_guard_manager.difference(goto_state.guard, dest_state.guard);
+    else
+    {
+      diff_guard=goto_state.guard;
+      diff_guard-=dest_state.guard;
+    }
   }
 
   for(std::unordered_set<ssa_exprt, irep_hash>::const_iterator
@@ -12,8 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_symex.h"
 
 #include <cassert>
+#include <chrono>
+#include <map>
 #include <memory>
 
+#include <util/profiler.h>
 #include <util/std_expr.h>
 #include <util/rename.h>
 #include <util/symbol_table.h>
@@ -144,9 +147,27 @@ void goto_symext::operator()(
 
   assert(state.top().end_of_function->is_end_function());
 
+  // time and number of steps per function, for profiling
+  typedef std::pair<std::chrono::steady_clock::duration, std::size_t>
+    step_timet;
+  std::map<irep_idt, step_timet> function_times;
+  const bool profile=profiler.is_enabled();
+
   while(!state.call_stack().empty())
   {
-    symex_step(goto_functions, state);
+    if(profile)
+    {
+      const irep_idt function=state.source.pc->function;
+      const auto start=std::chrono::steady_clock::now();
+
+      symex_step(goto_functions, state);
+
+      auto &function_time=function_times[function];
+      function_time.first+=std::chrono::steady_clock::now()-start;
+      ++function_time.second;
+    }
+    else
+      symex_step(goto_functions, state);
 
     // is there another thread to execute?
     if(state.call_stack().empty() &&
@@ -160,6 +181,12 @@ void goto_symext::operator()(
   }
 
   state.dirty=nullptr;
+
+  for(const auto &function_time : function_times)
+    profiler.add_time(
+      id2string(function_time.first),
+      function_time.second.first,
+      function_time.second.second);
 }
 
 /// symex starting from given program
@@ -235,7 +262,12 @@ void goto_symext::symex_step(
     break;
 
   case GOTO:
-    symex_goto(state);
+    // an irrelevant goto falls through, as when sliced away; in
+    // particular, irrelevant loops are not unwound
+    if(irrelevant_instructions.count(instruction.location_number))
+      symex_transition(state);
+    else
+      symex_goto(state);
     break;
 
   case ASSUME:
@@ -272,7 +304,8 @@ void goto_symext::symex_step(
     break;
 
   case ASSIGN:
-    if(!state.guard.is_false())
+    if(!state.guard.is_false() &&
+       !irrelevant_instructions.count(instruction.location_number))
       symex_assign_rec(state, to_code_assign(instruction.code));
 
     symex_transition(state);
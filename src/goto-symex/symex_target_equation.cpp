@@ -20,12 +20,58 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/prop/prop.h>
 #include <solvers/prop/literal_expr.h>
 
+#include "build_goto_trace.h"
 #include "goto_symex_state.h"
 
 symex_target_equationt::symex_target_equationt(
-  const namespacet &_ns):ns(_ns)
-{
-}
+  const namespacet &_ns):
+  ns(_ns),
+  converted_steps(0),
+  converted_assumptions(const_literal(true)),
+  converted_io_count(0),
+  streaming_prop_conv(nullptr),
+  cost_prop_conv(nullptr)
+{
+}
+
+/// Adds the cost of the conversion that happens during its lifetime to
+/// a step, if cost accounting is enabled
+class symex_target_equationt::cost_scopet
+{
+public:
+  cost_scopet(
+    const symex_target_equationt &_equation,
+    const SSA_stept &_step):
+    equation(_equation),
+    step(_step),
+    prop_conv(_equation.cost_prop_conv)
+  {
+    if(prop_conv==nullptr)
+      return;
+
+    variables=prop_conv->get_number_of_variables();
+    clauses=prop_conv->get_number_of_clauses();
+    start=std::chrono::steady_clock::now();
+  }
+
+  ~cost_scopet()
+  {
+    if(prop_conv==nullptr)
+      return;
+
+    conversion_costt &cost=equation.conversion_costs[&step];
+    cost.time+=std::chrono::steady_clock::now()-start;
+    cost.variables+=prop_conv->get_number_of_variables()-variables;
+    cost.clauses+=prop_conv->get_number_of_clauses()-clauses;
+  }
+
+protected:
+  const symex_target_equationt &equation;
+  const SSA_stept &step;
+  const prop_convt *prop_conv;
+  std::size_t variables, clauses;
+  std::chrono::steady_clock::time_point start;
+};
 
 symex_target_equationt::~symex_target_equationt()
 {
@@ -47,7 +93,7 @@ void symex_target_equationt::shared_read(
   SSA_step.atomic_section_id=atomic_section_id;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// write to a sharedvariable
@@ -66,7 +112,7 @@ void symex_target_equationt::shared_write(
   SSA_step.atomic_section_id=atomic_section_id;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// spawn a new thread
@@ -80,7 +126,7 @@ void symex_target_equationt::spawn(
   SSA_step.type=goto_trace_stept::typet::SPAWN;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 void symex_target_equationt::memory_barrier(
@@ -93,7 +139,7 @@ void symex_target_equationt::memory_barrier(
   SSA_step.type=goto_trace_stept::typet::MEMORY_BARRIER;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// start an atomic section
@@ -109,7 +155,7 @@ void symex_target_equationt::atomic_begin(
   SSA_step.atomic_section_id=atomic_section_id;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// end an atomic section
@@ -125,7 +171,7 @@ void symex_target_equationt::atomic_end(
   SSA_step.atomic_section_id=atomic_section_id;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// write to a variable
@@ -156,7 +202,7 @@ void symex_target_equationt::assignment(
                    assignment_type!=assignment_typet::VISIBLE_ACTUAL_PARAMETER);
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// declare a fresh variable
@@ -183,7 +229,7 @@ void symex_target_equationt::decl(
   // there so we see the symbols
   SSA_step.cond_expr=equal_exprt(SSA_step.ssa_lhs, SSA_step.ssa_lhs);
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// declare a fresh variable
@@ -207,7 +253,7 @@ void symex_target_equationt::location(
   SSA_step.type=goto_trace_stept::typet::LOCATION;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// just record a location
@@ -224,7 +270,7 @@ void symex_target_equationt::function_call(
   SSA_step.source=source;
   SSA_step.identifier=identifier;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// just record a location
@@ -241,7 +287,7 @@ void symex_target_equationt::function_return(
   SSA_step.source=source;
   SSA_step.identifier=identifier;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// just record output
@@ -260,7 +306,7 @@ void symex_target_equationt::output(
   SSA_step.io_args=args;
   SSA_step.io_id=output_id;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// just record formatted output
@@ -282,7 +328,7 @@ void symex_target_equationt::output_fmt(
   SSA_step.formatted=true;
   SSA_step.format_string=fmt;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// just record input
@@ -301,7 +347,7 @@ void symex_target_equationt::input(
   SSA_step.io_args=args;
   SSA_step.io_id=input_id;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// record an assumption
@@ -318,7 +364,7 @@ void symex_target_equationt::assumption(
   SSA_step.type=goto_trace_stept::typet::ASSUME;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// record an assertion
@@ -337,7 +383,7 @@ void symex_target_equationt::assertion(
   SSA_step.source=source;
   SSA_step.comment=msg;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// record a goto instruction
@@ -354,7 +400,7 @@ void symex_target_equationt::goto_instruction(
   SSA_step.type=goto_trace_stept::typet::GOTO;
   SSA_step.source=source;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 /// record a constraint
@@ -373,7 +419,7 @@ void symex_target_equationt::constraint(
   SSA_step.source=source;
   SSA_step.comment=msg;
 
-  merge_ireps(SSA_step);
+  record_step(SSA_step);
 }
 
 void symex_target_equationt::convert(
@@ -389,6 +435,155 @@ void symex_target_equationt::convert(
   convert_constraints(prop_conv);
 }
 
+/// Converts a single step; assertions are converted in the same way as by
+/// convert_assertions, but the disjunction of their negations is left to
+/// the caller. The assumptions seen so far are carried over to the steps
+/// converted later.
+void symex_target_equationt::convert_step(
+  SSA_stept &step,
+  prop_convt &prop_conv)
+{
+  ++converted_steps;
+
+  cost_scopet cost_scope(*this, step);
+
+  if(step.ignore)
+  {
+    step.guard_literal=const_literal(false);
+    if(step.is_assume() || step.is_goto())
+      step.cond_literal=const_literal(true);
+    return;
+  }
+
+  step.guard_literal=prop_conv.convert(step.guard);
+
+  if(step.is_assignment() || step.is_constraint())
+    prop_conv.set_to_true(step.cond_expr);
+  else if(step.is_decl())
+    prop_conv.convert(step.cond_expr);
+  else if(step.is_assume())
+  {
+    step.cond_literal=prop_conv.convert(step.cond_expr);
+    converted_assumptions=
+      prop_conv.convert(
+        and_exprt(
+          literal_exprt(converted_assumptions),
+          literal_exprt(step.cond_literal)));
+  }
+  else if(step.is_assert())
+    step.cond_literal=
+      prop_conv.convert(
+        implies_exprt(
+          literal_exprt(converted_assumptions),
+          step.cond_expr));
+  else if(step.is_goto())
+    step.cond_literal=prop_conv.convert(step.cond_expr);
+
+  for(const auto &arg : step.io_args)
+  {
+    if(arg.is_constant() ||
+       arg.id()==ID_string_constant)
+      step.converted_io_args.push_back(arg);
+    else
+    {
+      symbol_exprt symbol;
+      symbol.type()=arg.type();
+      symbol.set_identifier(
+        "symex::io::"+std::to_string(converted_io_count++));
+
+      equal_exprt eq(arg, symbol);
+      if(streaming_prop_conv==nullptr)
+        merge_irep(eq);
+
+      prop_conv.set_to(eq, true);
+      step.converted_io_args.push_back(symbol);
+    }
+  }
+}
+
+/// Converts the steps added since the last call in a way that permits
+/// solving with assumptions, see convert_step.
+/// \return the first step converted by this call
+symex_target_equationt::SSA_stepst::iterator
+symex_target_equationt::convert_incremental(prop_convt &prop_conv)
+{
+  SSA_stepst::iterator first=get_SSA_step(converted_steps);
+
+  for(SSA_stepst::iterator it=first; it!=SSA_steps.end(); ++it)
+    convert_step(*it, prop_conv);
+
+  return first;
+}
+
+/// From now on, each step is converted as soon as it is recorded. The
+/// expressions that build_goto_trace does not need are then dropped, so
+/// that the formula does not have to be kept in both forms.
+void symex_target_equationt::start_streaming(prop_convt &prop_conv)
+{
+  assert(SSA_steps.empty());
+  streaming_prop_conv=&prop_conv;
+}
+
+/// Adds the disjunction of the negated assertions of all streamed steps,
+/// as convert_assertions does.
+void symex_target_equationt::finish_streaming()
+{
+  assert(streaming_prop_conv!=nullptr);
+
+  or_exprt::operandst disjuncts;
+
+  for(const auto &step : SSA_steps)
+    if(step.is_assert())
+      disjuncts.push_back(literal_exprt(!step.cond_literal));
+
+  if(!disjuncts.empty())
+    streaming_prop_conv->set_to_true(disjunction(disjuncts));
+}
+
+/// Finishes recording a step: in streaming mode, the step is converted
+/// and reduced to what is needed for traces; otherwise its expressions
+/// are merged with those of other steps.
+void symex_target_equationt::record_step(SSA_stept &SSA_step)
+{
+  if(streaming_prop_conv==nullptr)
+  {
+    merge_ireps(SSA_step);
+    return;
+  }
+
+  convert_step(SSA_step, *streaming_prop_conv);
+
+  // the memory model needs the guards of events
+  if(!SSA_step.is_shared_read() &&
+     !SSA_step.is_shared_write() &&
+     !SSA_step.is_spawn() &&
+     !SSA_step.is_memory_barrier() &&
+     !SSA_step.is_atomic_begin() &&
+     !SSA_step.is_atomic_end())
+    SSA_step.guard.make_nil();
+
+  // traces need the conditions of assertions, assumptions and gotos only
+  if(SSA_step.is_assignment() ||
+     SSA_step.is_decl() ||
+     SSA_step.is_constraint())
+    SSA_step.cond_expr.make_nil();
+
+  // traces only need to know whether the rhs mentions a dynamic object,
+  // and the full lhs where it differs from the lhs
+  if(SSA_step.ssa_rhs.is_not_nil())
+  {
+    SSA_step.dynamic_object=has_dynamic_object(SSA_step.ssa_rhs, ns);
+    SSA_step.ssa_rhs.make_nil();
+  }
+
+  if(SSA_step.ssa_full_lhs==SSA_step.ssa_lhs)
+    SSA_step.ssa_full_lhs.make_nil();
+
+  SSA_step.io_args.clear();
+
+  merge_ireps(SSA_step);
+}
+
 /// converts assignments
 /// \par parameters: decision procedure
 /// \return -
@@ -398,7 +593,10 @@ void symex_target_equationt::convert_assignments(
   for(const auto &step : SSA_steps)
   {
     if(step.is_assignment() && !step.ignore)
+    {
+      cost_scopet cost_scope(*this, step);
       decision_procedure.set_to_true(step.cond_expr);
+    }
   }
 }
 
@@ -411,6 +609,8 @@ void symex_target_equationt::convert_decls(
   {
     if(step.is_decl() && !step.ignore)
     {
+      cost_scopet cost_scope(*this, step);
+
       // The result is not used, these have no impact on
       // the satisfiability of the formula.
       prop_conv.convert(step.cond_expr);
@@ -428,7 +628,10 @@ void symex_target_equationt::convert_guards(
     if(step.ignore)
       step.guard_literal=const_literal(false);
     else
+    {
+      cost_scopet cost_scope(*this, step);
       step.guard_literal=prop_conv.convert(step.guard);
+    }
   }
 }
 
@@ -444,7 +647,10 @@ void symex_target_equationt::convert_assumptions(
       if(step.ignore)
         step.cond_literal=const_literal(true);
       else
+      {
+        cost_scopet cost_scope(*this, step);
         step.cond_literal=prop_conv.convert(step.cond_expr);
+      }
     }
   }
 }
@@ -461,7 +667,10 @@ void symex_target_equationt::convert_goto_instructions(
       if(step.ignore)
         step.cond_literal=const_literal(true);
       else
+      {
+        cost_scopet cost_scope(*this, step);
         step.cond_literal=prop_conv.convert(step.cond_expr);
+      }
     }
   }
 }
@@ -479,6 +688,7 @@ void symex_target_equationt::convert_constraints(
       if(step.ignore)
         continue;
 
+      cost_scopet cost_scope(*this, step);
       decision_procedure.set_to_true(step.cond_expr);
     }
   }
@@ -503,12 +713,16 @@ void symex_target_equationt::convert_assertions(
     {
       if(step.is_assert())
       {
+        cost_scopet cost_scope(*this, step);
         prop_conv.set_to_false(step.cond_expr);
         step.cond_literal=const_literal(false);
         return; // prevent further assumptions!
       }
       else if(step.is_assume())
+      {
+        cost_scopet cost_scope(*this, step);
         prop_conv.set_to_true(step.cond_expr);
+      }
     }
 
     UNREACHABLE; // unreachable
@@ -530,6 +744,7 @@ void symex_target_equationt::convert_assertions(
         step.cond_expr);
 
       // do the conversion
+      cost_scopet cost_scope(*this, step);
       step.cond_literal=prop_conv.convert(implication);
 
       // store disjunct
@@ -562,6 +777,8 @@ void symex_target_equationt::convert_io(
   for(auto &step : SSA_steps)
     if(!step.ignore)
     {
+      cost_scopet cost_scope(*this, step);
+
       for(const auto &arg : step.io_args)
       {
         if(arg.is_constant() ||
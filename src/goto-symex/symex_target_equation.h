@@ -12,8 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
 #define CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
 
+#include <chrono>
 #include <list>
 #include <iosfwd>
+#include <unordered_map>
 
 #include <util/merge_irep.h>
 
@@ -217,6 +219,9 @@ public:
     exprt ssa_full_lhs, original_full_lhs;
     exprt ssa_rhs;
     assignment_typet assignment_type;
+    // whether ssa_rhs mentions a dynamic object, for traces once ssa_rhs
+    // has been dropped
+    bool dynamic_object=false;
 
     // for ASSUME/ASSERT/GOTO/CONSTRAINT
     exprt cond_expr;
@@ -248,6 +253,7 @@ public:
       original_full_lhs(static_cast<const exprt &>(get_nil_irep())),
       ssa_rhs(static_cast<const exprt &>(get_nil_irep())),
       assignment_type(assignment_typet::STATE),
+      dynamic_object(false),
       cond_expr(static_cast<const exprt &>(get_nil_irep())),
       cond_literal(const_literal(false)),
       formatted(false),
@@ -286,6 +292,48 @@ public:
   typedef std::list<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
+  // incremental solving: converts only the steps that were added since
+  // the last call, and returns the first of them
+  SSA_stepst::iterator convert_incremental(prop_convt &prop_conv);
+
+  // streaming: converts each step as soon as it is recorded
+  void start_streaming(prop_convt &prop_conv);
+  void finish_streaming();
+  bool is_streaming() const
+  {
+    return streaming_prop_conv!=nullptr;
+  }
+
+  // cost accounting: the variables and clauses that \p prop_conv adds
+  // while a step is converted, and the time taken, are attributed to
+  // the step
+  struct conversion_costt
+  {
+    conversion_costt():
+      variables(0),
+      clauses(0),
+      time(std::chrono::steady_clock::duration::zero())
+    {
+    }
+
+    std::size_t variables;
+    std::size_t clauses;
+    std::chrono::steady_clock::duration time;
+  };
+
+  typedef std::unordered_map<const SSA_stept *, conversion_costt>
+    conversion_costst;
+
+  void enable_cost_accounting(const prop_convt &prop_conv)
+  {
+    cost_prop_conv=&prop_conv;
+  }
+
+  const conversion_costst &get_conversion_costs() const
+  {
+    return conversion_costs;
+  }
+
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
     SSA_stepst::iterator it=SSA_steps.begin();
@@ -318,6 +366,22 @@ public:
 protected:
   const namespacet &ns;
 
+  // state of convert_incremental and streaming
+  std::size_t converted_steps;
+  literalt converted_assumptions;
+  std::size_t converted_io_count;
+  prop_convt *streaming_prop_conv;
+
+  void convert_step(SSA_stept &step, prop_convt &prop_conv);
+  void record_step(SSA_stept &SSA_step);
+
+  // state of cost accounting; expressions shared by several steps are
+  // converted only once and count for the first of them
+  const prop_convt *cost_prop_conv;
+  mutable conversion_costst conversion_costs;
+
+  class cost_scopet;
+
   // for enforcing sharing in the expressions stored
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
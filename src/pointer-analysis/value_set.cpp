@@ -243,19 +243,80 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
   return result;
 }
 
+/// \return true if merging \p other into this map would not change it,
+///   i.e., every object of \p other is present with the same offset or with
+///   an unknown offset
+bool value_sett::object_map_dt::is_subsumed(const object_map_dt &other) const
+{
+  const_iterator it=data.begin();
+
+  for(const auto &entry : other.data)
+  {
+    while(it!=data.end() && it->first<entry.first)
+      ++it;
+
+    if(it==data.end() || it->first!=entry.first)
+      return false;
+
+    if(it->second.offset_is_set && it->second!=entry.second)
+      return false;
+  }
+
+  return true;
+}
+
+/// Merges \p other into this map in a single linear pass over both sorted
+/// entry vectors. Objects present in both maps with different offsets end
+/// up with an unknown offset.
+void value_sett::object_map_dt::make_union(const object_map_dt &other)
+{
+  data_typet result;
+  result.reserve(data.size()+other.data.size());
+
+  const_iterator it1=data.begin();
+  const_iterator it2=other.data.begin();
+
+  while(it1!=data.end() && it2!=other.data.end())
+  {
+    if(it1->first<it2->first)
+      result.push_back(*(it1++));
+    else if(it2->first<it1->first)
+      result.push_back(*(it2++));
+    else
+    {
+      result.push_back(*it1);
+      if(it1->second!=it2->second)
+        result.back().second.offset_is_set=false;
+      ++it1;
+      ++it2;
+    }
+  }
+
+  result.insert(result.end(), it1, data.cend());
+  result.insert(result.end(), it2, other.data.cend());
+
+  data.swap(result);
+}
+
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  // identical (shared) maps and empty sources cannot add anything
+  if(dest.get_d()==src.get_d() || src.read().empty())
+    return false;
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  // share the source rather than copying it
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    dest=src;
+    return true;
   }
 
-  return result;
+  if(dest.read().is_subsumed(src.read()))
+    return false;
+
+  dest.write().make_union(src.read());
+
+  return true;
 }
 
 bool value_sett::eval_pointer_offset(
@@ -12,7 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 #define CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 
+#include <algorithm>
 #include <set>
+#include <stdexcept>
+#include <vector>
 
 #include <util/mp_arith.h>
 #include <util/reference_counting.h>
@@ -69,20 +72,33 @@ public:
     }
   };
 
+  /// Map from object numbers to offsets. Value sets are typically small
+  /// and are copied and merged very frequently, hence the entries are kept
+  /// in a vector sorted by object number rather than in a node-based map:
+  /// lookups are binary searches and unions are linear merges over
+  /// contiguous memory.
   class object_map_dt
   {
-    typedef std::map<object_numberingt::number_type, objectt> data_typet;
+  public:
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef object_numberingt::number_type key_type;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef std::pair<key_type, objectt> value_type;
+
+  private:
+    typedef std::vector<value_type> data_typet;
     data_typet data;
 
+    static bool key_less(const value_type &v, key_type k)
+    {
+      return v.first<k;
+    }
+
   public:
     // NOLINTNEXTLINE(readability/identifiers)
     typedef data_typet::iterator iterator;
     // NOLINTNEXTLINE(readability/identifiers)
     typedef data_typet::const_iterator const_iterator;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::value_type value_type;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::key_type key_type;
 
     iterator begin() { return data.begin(); }
     const_iterator begin() const { return data.begin(); }
@@ -95,18 +111,72 @@ public:
     size_t size() const { return data.size(); }
     bool empty() const { return data.empty(); }
 
-    void erase(key_type i) { data.erase(i); }
+    iterator lower_bound(key_type i)
+    {
+      return std::lower_bound(data.begin(), data.end(), i, key_less);
+    }
+
+    const_iterator lower_bound(key_type i) const
+    {
+      return std::lower_bound(data.begin(), data.end(), i, key_less);
+    }
+
+    const_iterator find(key_type i) const
+    {
+      const_iterator it=lower_bound(i);
+      if(it!=data.end() && it->first==i)
+        return it;
+      return data.end();
+    }
+
+    void erase(key_type i)
+    {
+      iterator it=lower_bound(i);
+      if(it!=data.end() && it->first==i)
+        data.erase(it);
+    }
+
     void erase(const_iterator it) { data.erase(it); }
 
-    objectt &operator[](key_type i) { return data[i]; }
-    objectt &at(key_type i) { return data.at(i); }
-    const objectt &at(key_type i) const { return data.at(i); }
+    objectt &operator[](key_type i)
+    {
+      iterator it=lower_bound(i);
+      if(it==data.end() || it->first!=i)
+        it=data.insert(it, value_type(i, objectt()));
+      return it->second;
+    }
 
+    objectt &at(key_type i)
+    {
+      iterator it=lower_bound(i);
+      if(it==data.end() || it->first!=i)
+        throw std::out_of_range("object_map_dt::at");
+      return it->second;
+    }
+
+    const objectt &at(key_type i) const
+    {
+      const_iterator it=find(i);
+      if(it==data.end())
+        throw std::out_of_range("object_map_dt::at");
+      return it->second;
+    }
+
+    /// Inserts the entries in [b, e) whose keys are not yet present,
+    /// following the semantics of std::map::insert.
     template <typename It>
-    void insert(It b, It e) { data.insert(b, e); }
+    void insert(It b, It e)
+    {
+      for(; b!=e; ++b)
+      {
+        iterator it=lower_bound(b->first);
+        if(it==data.end() || it->first!=b->first)
+          data.insert(it, value_type(b->first, b->second));
+      }
+    }
 
-    template <typename T>
-    const_iterator find(T &&t) const { return data.find(std::forward<T>(t)); }
+    bool is_subsumed(const object_map_dt &other) const;
+    void make_union(const object_map_dt &other);
 
     static const object_map_dt blank;
 
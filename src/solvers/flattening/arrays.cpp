@@ -28,6 +28,7 @@ arrayst::arrayst(
 {
   lazy_arrays = false;        // will be set to true when --refine is used
   incremental_cache = false;  // for incremental solving
+  constrained_arrays = 0;
 }
 
 void arrayst::record_array_index(const index_exprt &index)
@@ -258,6 +259,21 @@ void arrayst::add_array_constraint(const lazy_constraintt &lazy, bool refine)
   }
 }
 
+/// \return the indices in \p index_set that are not in \p constrained,
+///   which are then added to \p constrained
+static std::set<exprt> new_indices(
+  const std::set<exprt> &index_set,
+  std::set<exprt> &constrained)
+{
+  std::set<exprt> result;
+
+  for(const auto &index : index_set)
+    if(constrained.insert(index).second)
+      result.insert(result.end(), index);
+
+  return result;
+}
+
 void arrayst::add_array_constraints()
 {
   collect_indices();
@@ -273,17 +289,28 @@ void arrayst::add_array_constraints()
     // in case of nested unbounded arrays
     exprt a=arrays[i];
 
-    add_array_constraints(index_map[arrays.find_number(i)], a);
+    if(i>=constrained_arrays && a.id()==ID_with)
+      add_array_constraints_with_index(to_with_expr(a));
+
+    // if post-processing is repeated, the constraints of the indices
+    // seen before have been added already
+    add_array_constraints(
+      new_indices(index_map[arrays.find_number(i)], constrained_index_map[i]),
+      a);
 
     // we have to update before it gets used in the next add_* call
     update_index_map(false);
   }
 
+  constrained_arrays=arrays.size();
+
   // add constraints for equalities
-  for(const auto &equality : array_equalities)
+  for(auto &equality : array_equalities)
   {
     add_array_constraints_equality(
-      index_map[arrays.find_number(equality.f1)],
+      new_indices(
+        index_map[arrays.find_number(equality.f1)],
+        equality.constrained_indices),
       equality);
 
     // update_index_map should not be necessary here
@@ -306,6 +333,10 @@ void arrayst::add_array_Ackermann_constraints()
   {
     const index_sett &index_set=index_map[arrays.find_number(i)];
 
+    // the pairs of indices seen before have been constrained already
+    const index_sett new_index_set=
+      new_indices(index_set, ackermann_index_map[i]);
+
 #ifdef DEBUG
     std::cout << "index_set.size(): " << index_set.size() << '\n';
 #endif
@@ -315,47 +346,53 @@ void arrayst::add_array_Ackermann_constraints()
         i1=index_set.begin();
         i1!=index_set.end();
         i1++)
+    {
+      // a new index is paired with all that follow, one seen before
+      // only with the new ones
+      const bool i1_new=new_index_set.count(*i1)!=0;
+      const index_sett &others=i1_new?index_set:new_index_set;
+
       for(index_sett::const_iterator
-          i2=i1;
-          i2!=index_set.end();
+          i2=others.upper_bound(*i1);
+          i2!=others.end();
           i2++)
-        if(i1!=i2)
-        {
-          if(i1->is_constant() && i2->is_constant())
-            continue;
+      {
+        if(i1->is_constant() && i2->is_constant())
+          continue;
 
-          // index equality
-          equal_exprt indices_equal(*i1, *i2);
+        // index equality
+        equal_exprt indices_equal(*i1, *i2);
 
-          if(indices_equal.op0().type()!=
-             indices_equal.op1().type())
-          {
-            indices_equal.op1().
-              make_typecast(indices_equal.op0().type());
-          }
+        if(indices_equal.op0().type()!=
+           indices_equal.op1().type())
+        {
+          indices_equal.op1().
+            make_typecast(indices_equal.op0().type());
+        }
 
-          literalt indices_equal_lit=convert(indices_equal);
+        literalt indices_equal_lit=convert(indices_equal);
 
-          if(indices_equal_lit!=const_literal(false))
-          {
-            const typet &subtype=ns.follow(arrays[i].type()).subtype();
-            index_exprt index_expr1(arrays[i], *i1, subtype);
+        if(indices_equal_lit!=const_literal(false))
+        {
+          const typet &subtype=ns.follow(arrays[i].type()).subtype();
+          index_exprt index_expr1(arrays[i], *i1, subtype);
 
-            index_exprt index_expr2=index_expr1;
-            index_expr2.index()=*i2;
+          index_exprt index_expr2=index_expr1;
+          index_expr2.index()=*i2;
 
-            equal_exprt values_equal(index_expr1, index_expr2);
+          equal_exprt values_equal(index_expr1, index_expr2);
 
-            // add constraint
-            lazy_constraintt lazy(lazy_typet::ARRAY_ACKERMANN,
-              implies_exprt(literal_exprt(indices_equal_lit), values_equal));
-            add_array_constraint(lazy, true); // added lazily
+          // add constraint
+          lazy_constraintt lazy(lazy_typet::ARRAY_ACKERMANN,
+            implies_exprt(literal_exprt(indices_equal_lit), values_equal));
+          add_array_constraint(lazy, true); // added lazily
 
 #if 0 // old code for adding, not significantly faster
-            prop.lcnf(!indices_equal_lit, convert(values_equal));
+          prop.lcnf(!indices_equal_lit, convert(values_equal));
 #endif
-          }
         }
+      }
+    }
   }
 }
 
@@ -511,26 +548,9 @@ void arrayst::add_array_constraints_with(
   const with_exprt &expr)
 {
   // we got x=(y with [i:=v])
-  // add constraint x[i]=v
+  // the constraint x[i]=v is added by add_array_constraints_with_index
 
   const exprt &index=expr.where();
-  const exprt &value=expr.new_value();
-
-  {
-    index_exprt index_expr(expr, index, ns.follow(expr.type()).subtype());
-
-    if(index_expr.type()!=value.type())
-    {
-      prop.error() << expr.pretty() << messaget::eom;
-      DATA_INVARIANT(
-        false,
-        "with-expression operand should match array element type");
-    }
-
-    lazy_constraintt lazy(
-       lazy_typet::ARRAY_WITH, equal_exprt(index_expr, value));
-     add_array_constraint(lazy, false); // added immediately
-  }
 
   // use other array index applications for "else" case
   // add constraint x[I]=y[I] for I!=i
@@ -575,6 +595,29 @@ void arrayst::add_array_constraints_with(
   }
 }
 
+void arrayst::add_array_constraints_with_index(const with_exprt &expr)
+{
+  // we got x=(y with [i:=v])
+  // add constraint x[i]=v
+
+  const exprt &index=expr.where();
+  const exprt &value=expr.new_value();
+
+  index_exprt index_expr(expr, index, ns.follow(expr.type()).subtype());
+
+  if(index_expr.type()!=value.type())
+  {
+    prop.error() << expr.pretty() << messaget::eom;
+    DATA_INVARIANT(
+      false,
+      "with-expression operand should match array element type");
+  }
+
+  lazy_constraintt lazy(
+    lazy_typet::ARRAY_WITH, equal_exprt(index_expr, value));
+  add_array_constraint(lazy, false); // added immediately
+}
+
 void arrayst::add_array_constraints_update(
   const index_sett &index_set,
   const update_exprt &expr)
@@ -48,10 +48,14 @@ protected:
     add_array_constraints();
   }
 
+  typedef std::set<exprt> index_sett;
+
   struct array_equalityt
   {
     literalt l;
     exprt f1, f2;
+    // the indices for which x=y => x[i]=y[i] has been added
+    index_sett constrained_indices;
   };
 
   // the list of all equalities between arrays
@@ -64,12 +68,20 @@ protected:
   union_find<exprt> arrays;
 
   // this tracks the array indicies for each array
-  typedef std::set<exprt> index_sett;
   // references to values in this container need to be stable as
   // elements are added while references are held
   typedef std::map<std::size_t, index_sett> index_mapt;
   index_mapt index_map;
 
+  // When post-processing is repeated, as the formula grows, only the
+  // constraints for arrays and indices that are new since the last call
+  // are added. These track, per array number, the indices for which the
+  // constraints of the array and the Ackermann constraints have been
+  // added, and the number of arrays processed so far.
+  index_mapt constrained_index_map;
+  index_mapt ackermann_index_map;
+  std::size_t constrained_arrays;
+
   // adds array constraints lazily
   enum class lazy_typet
   {
@@ -109,6 +121,7 @@ protected:
     const index_sett &index_set, const if_exprt &exprt);
   void add_array_constraints_with(
     const index_sett &index_set, const with_exprt &expr);
+  void add_array_constraints_with_index(const with_exprt &expr);
   void add_array_constraints_update(
     const index_sett &index_set, const update_exprt &expr);
   void add_array_constraints_array_of(
@@ -90,12 +90,11 @@ literalt equalityt::equality2(const exprt &e1, const exprt &e2)
 
 void equalityt::add_equality_constraints()
 {
-  for(typemapt::const_iterator it=typemap.begin();
-      it!=typemap.end(); it++)
-    add_equality_constraints(it->second);
+  for(auto &entry : typemap)
+    add_equality_constraints(entry.second);
 }
 
-void equalityt::add_equality_constraints(const typestructt &typestruct)
+void equalityt::add_equality_constraints(typestructt &typestruct)
 {
   std::size_t no_elements=typestruct.elements.size();
   std::size_t bits=0;
@@ -105,13 +104,19 @@ void equalityt::add_equality_constraints(const typestructt &typestruct)
   for(std::size_t i=no_elements; i!=0; bits++)
     i=(i>>1);
 
-  // generate bit vectors
+  // generate bit vectors; those of elements that were constrained by an
+  // earlier call are extended by zeros, which leaves enough room to give
+  // every element a distinct value
 
-  std::vector<bvt> eq_bvs;
+  std::vector<bvt> &eq_bvs=typestruct.eq_bvs;
 
+  for(auto &bv : eq_bvs)
+    bv.resize(bits, const_literal(false));
+
+  std::size_t no_old_elements=eq_bvs.size();
   eq_bvs.resize(no_elements);
 
-  for(std::size_t i=0; i<no_elements; i++)
+  for(std::size_t i=no_old_elements; i<no_elements; i++)
   {
     eq_bvs[i].resize(bits);
     for(std::size_t j=0; j<bits; j++)
@@ -132,4 +137,7 @@ void equalityt::add_equality_constraints(const typestructt &typestruct)
 
     prop.set_equal(bv_utils.equal(bv1, bv2), it->second);
   }
+
+  // if called incrementally, don't do these twice
+  typestruct.equalities.clear();
 }
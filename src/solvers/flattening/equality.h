@@ -29,7 +29,6 @@ public:
   {
     add_equality_constraints();
     prop_conv_solvert::post_process();
-    typemap.clear(); // if called incrementally, don't do it twice
   }
 
 protected:
@@ -42,6 +41,9 @@ protected:
     elementst elements;
     elements_revt elements_rev;
     equalitiest equalities;
+    // the bit vectors that encode the elements, see
+    // add_equality_constraints
+    std::vector<bvt> eq_bvs;
   };
 
   typedef std::unordered_map<const typet, typestructt, irep_hash> typemapt;
@@ -50,7 +52,7 @@ protected:
 
   virtual literalt equality2(const exprt &e1, const exprt &e2);
   virtual void add_equality_constraints();
-  virtual void add_equality_constraints(const typestructt &typestruct);
+  virtual void add_equality_constraints(typestructt &typestruct);
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_EQUALITY_H
@@ -16,17 +16,17 @@ Author: Daniel Kroening, kroening@kroening.com
 void functionst::record(
   const function_application_exprt &function_application)
 {
-  function_map[function_application.function()].applications.
-    insert(function_application);
+  function_infot &info=function_map[function_application.function()];
+
+  const auto entry=info.applications.insert(function_application);
+  if(entry.second)
+    info.recorded.push_back(entry.first);
 }
 
 void functionst::add_function_constraints()
 {
-  for(function_mapt::const_iterator it=
-      function_map.begin();
-      it!=function_map.end();
-      it++)
-    add_function_constraints(it->second);
+  for(auto &entry : function_map)
+    add_function_constraints(entry.second);
 }
 
 exprt functionst::arguments_equal(const exprt::operandst &o1,
@@ -55,28 +55,30 @@ exprt functionst::arguments_equal(const exprt::operandst &o1,
   return and_expr;
 }
 
-void functionst::add_function_constraints(const function_infot &info)
+void functionst::add_function_constraints(function_infot &info)
 {
   // Do Ackermann's function reduction.
   // This is quadratic, slow, and needs to be modernized.
+  // If called incrementally, only the pairs with an application recorded
+  // since the last call are added.
 
-  for(std::set<function_application_exprt>::const_iterator
-      it1=info.applications.begin();
-      it1!=info.applications.end();
-      it1++)
+  for(std::size_t i=info.constrained; i<info.recorded.size(); i++)
   {
-    for(std::set<function_application_exprt>::const_iterator
-        it2=info.applications.begin();
-        it2!=it1;
-        it2++)
+    const function_application_exprt &application1=*info.recorded[i];
+
+    for(std::size_t j=0; j<i; j++)
     {
+      const function_application_exprt &application2=*info.recorded[j];
+
       exprt arguments_equal_expr=
-        arguments_equal(it1->arguments(), it2->arguments());
+        arguments_equal(application1.arguments(), application2.arguments());
 
       implies_exprt implication(arguments_equal_expr,
-                                equal_exprt(*it1, *it2));
+                                equal_exprt(application1, application2));
 
       prop_conv.set_to_true(implication);
     }
   }
+
+  info.constrained=info.recorded.size();
 }
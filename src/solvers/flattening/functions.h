@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_FLATTENING_FUNCTIONS_H
 
 #include <set>
+#include <vector>
 
 #include <util/std_expr.h>
 
@@ -44,13 +45,17 @@ protected:
   struct function_infot
   {
     applicationst applications;
+    // the applications in the order they were recorded, of which the
+    // first `constrained' have been constrained already
+    std::vector<applicationst::const_iterator> recorded;
+    std::size_t constrained=0;
   };
 
   typedef std::map<exprt, function_infot> function_mapt;
   function_mapt function_map;
 
   virtual void add_function_constraints();
-  virtual void add_function_constraints(const function_infot &info);
+  virtual void add_function_constraints(function_infot &info);
 
   exprt arguments_equal(const exprt::operandst &o1,
                         const exprt::operandst &o2);
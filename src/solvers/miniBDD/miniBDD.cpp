@@ -189,7 +189,10 @@ void mini_bdd_mgrt::DumpTikZ(
 class mini_bdd_applyt
 {
 public:
-  inline explicit mini_bdd_applyt(bool (*_fkt)(bool, bool)):fkt(_fkt)
+  typedef mini_bdd_mgrt::opt opt;
+
+  mini_bdd_applyt(mini_bdd_mgrt &_mgr, opt _op, bool (*_fkt)(bool, bool)):
+    mgr(_mgr), op(_op), fkt(_fkt)
   {
   }
 
@@ -199,14 +202,50 @@ public:
   }
 
 protected:
+  typedef mini_bdd_mgrt::computed_keyt keyt;
+
+  mini_bdd_mgrt &mgr;
+  const opt op;
   bool (*fkt)(bool, bool);
   mini_bddt APP_rec(const mini_bddt &x, const mini_bddt &y);
   mini_bddt APP_non_rec(const mini_bddt &x, const mini_bddt &y);
 
-  typedef std::map<std::pair<unsigned, unsigned>, mini_bddt> Gt;
-  Gt G;
+  keyt key(const mini_bddt &x, const mini_bddt &y) const
+  {
+    return keyt{op, x.node->unique_id, y.node->unique_id};
+  }
+
+  bool lookup(const keyt &key, mini_bddt &result) const;
+  void store(const keyt &key, const mini_bddt &result);
 };
 
+bool mini_bdd_applyt::lookup(const keyt &key, mini_bddt &result) const
+{
+  mini_bdd_mgrt::computed_tablet::const_iterator it=
+    mgr.computed_table.find(key);
+
+  if(it==mgr.computed_table.end())
+    return false;
+
+  const mini_bdd_nodet *node=it->second.node;
+
+  // the node may have been freed, or even recycled, in the meantime
+  if(node->unique_id!=it->second.unique_id ||
+     (node->reference_counter==0 && node->node_number>=2))
+    return false;
+
+  result=mini_bddt(it->second.node);
+  return true;
+}
+
+void mini_bdd_applyt::store(const keyt &key, const mini_bddt &result)
+{
+  if(mgr.computed_table.size()>=mini_bdd_mgrt::computed_table_limit)
+    mgr.computed_table.clear();
+
+  mgr.computed_table[key]={ result.node, result.node->unique_id };
+}
+
 mini_bddt mini_bdd_applyt::APP_rec(const mini_bddt &x, const mini_bddt &y)
 {
   // NOLINTNEXTLINE(build/deprecated)
@@ -215,31 +254,27 @@ mini_bddt mini_bdd_applyt::APP_rec(const mini_bddt &x, const mini_bddt &y)
   assert(x.node->mgr==y.node->mgr);
 
   // dynamic programming
-  std::pair<unsigned, unsigned> key(x.node_number(), y.node_number());
-  Gt::const_iterator G_it=G.find(key);
-  if(G_it!=G.end())
-    return G_it->second;
-
-  mini_bdd_mgrt *mgr=x.node->mgr;
-
+  const keyt k=key(x, y);
   mini_bddt u;
+  if(lookup(k, u))
+    return u;
 
   if(x.is_constant() && y.is_constant())
-    u=mini_bddt(fkt(x.is_true(), y.is_true())?mgr->True():mgr->False());
+    u=mini_bddt(fkt(x.is_true(), y.is_true())?mgr.True():mgr.False());
   else if(x.var()==y.var())
-    u=mgr->mk(x.var(),
-              APP_rec(x.low(), y.low()),
-              APP_rec(x.high(), y.high()));
+    u=mgr.mk(x.var(),
+             APP_rec(x.low(), y.low()),
+             APP_rec(x.high(), y.high()));
   else if(x.var()<y.var())
-    u=mgr->mk(x.var(),
-              APP_rec(x.low(), y),
-              APP_rec(x.high(), y));
+    u=mgr.mk(x.var(),
+             APP_rec(x.low(), y),
+             APP_rec(x.high(), y));
   else /* x.var() > y.var() */
-    u=mgr->mk(y.var(),
-              APP_rec(x, y.low()),
-              APP_rec(x, y.high()));
+    u=mgr.mk(y.var(),
+             APP_rec(x, y.low()),
+             APP_rec(x, y.high()));
 
-  G[key]=u;
+  store(k, u);
 
   return u;
 }
@@ -253,12 +288,13 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
     stack_elementt(
       mini_bddt &_result,
       const mini_bddt &_x,
-      const mini_bddt &_y):
+      const mini_bddt &_y,
+      const keyt &_key):
       result(_result), x(_x), y(_y),
-      key(x.node_number(), y.node_number()),
+      key(_key),
       var(0), phase(phaset::INIT) { }
     mini_bddt &result, x, y, lr, hr;
-    std::pair<unsigned, unsigned> key;
+    keyt key;
     unsigned var;
     enum class phaset { INIT, FINISH } phase;
   };
@@ -266,7 +302,7 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
   mini_bddt u; // return value
 
   std::stack<stack_elementt> stack;
-  stack.push(stack_elementt(u, _x, _y));
+  stack.push(stack_elementt(u, _x, _y, key(_x, _y)));
 
   while(!stack.empty())
   {
@@ -283,10 +319,8 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
     case stack_elementt::phaset::INIT:
       {
         // dynamic programming
-        Gt::const_iterator G_it=G.find(t.key);
-        if(G_it!=G.end())
+        if(lookup(t.key, t.result))
         {
-          t.result=G_it->second;
           stack.pop();
         }
         else
@@ -294,7 +328,6 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
           if(x.is_constant() && y.is_constant())
           {
             bool result_truth=fkt(x.is_true(), y.is_true());
-            const mini_bdd_mgrt &mgr=*x.node->mgr;
             t.result=result_truth?mgr.True():mgr.False();
             stack.pop();
           }
@@ -310,8 +343,11 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
             assert(x.high().var()>t.var);
             // NOLINTNEXTLINE(build/deprecated)
             assert(y.high().var()>t.var);
-            stack.push(stack_elementt(t.lr, x.low(), y.low()));
-            stack.push(stack_elementt(t.hr, x.high(), y.high()));
+            stack.push(
+              stack_elementt(t.lr, x.low(), y.low(), key(x.low(), y.low())));
+            stack.push(
+              stack_elementt(
+                t.hr, x.high(), y.high(), key(x.high(), y.high())));
           }
           else if(x.var()<y.var())
           {
@@ -321,8 +357,8 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
             assert(x.low().var()>t.var);
             // NOLINTNEXTLINE(build/deprecated)
             assert(x.high().var()>t.var);
-            stack.push(stack_elementt(t.lr, x.low(), y));
-            stack.push(stack_elementt(t.hr, x.high(), y));
+            stack.push(stack_elementt(t.lr, x.low(), y, key(x.low(), y)));
+            stack.push(stack_elementt(t.hr, x.high(), y, key(x.high(), y)));
           }
           else /* x.var() > y.var() */
           {
@@ -332,8 +368,8 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
             assert(y.low().var()>t.var);
             // NOLINTNEXTLINE(build/deprecated)
             assert(y.high().var()>t.var);
-            stack.push(stack_elementt(t.lr, x, y.low()));
-            stack.push(stack_elementt(t.hr, x, y.high()));
+            stack.push(stack_elementt(t.lr, x, y.low(), key(x, y.low())));
+            stack.push(stack_elementt(t.hr, x, y.high(), key(x, y.high())));
           }
         }
       }
@@ -341,9 +377,8 @@ mini_bddt mini_bdd_applyt::APP_non_rec(
 
     case stack_elementt::phaset::FINISH:
       {
-        mini_bdd_mgrt *mgr=x.node->mgr;
-        t.result=mgr->mk(t.var, t.lr, t.hr);
-        G[t.key]=t.result;
+        t.result=mgr.mk(t.var, t.lr, t.hr);
+        store(t.key, t.result);
         stack.pop();
       }
       break;
@@ -363,7 +398,9 @@ bool equal_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator==(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(equal_fkt)(*this, other);
+  // NOLINTNEXTLINE(build/deprecated)
+  assert(is_initialized());
+  return node->mgr->apply(mini_bdd_mgrt::opt::EQUAL, *this, other);
 }
 
 bool xor_fkt(bool x, bool y)
@@ -373,7 +410,9 @@ bool xor_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator^(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(xor_fkt)(*this, other);
+  // NOLINTNEXTLINE(build/deprecated)
+  assert(is_initialized());
+  return node->mgr->apply(mini_bdd_mgrt::opt::XOR, *this, other);
 }
 
 mini_bddt mini_bddt::operator!() const
@@ -390,7 +429,9 @@ bool and_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator&(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(and_fkt)(*this, other);
+  // NOLINTNEXTLINE(build/deprecated)
+  assert(is_initialized());
+  return node->mgr->apply(mini_bdd_mgrt::opt::AND, *this, other);
 }
 
 bool or_fkt(bool x, bool y)
@@ -400,10 +441,30 @@ bool or_fkt(bool x, bool y)
 
 mini_bddt mini_bddt::operator|(const mini_bddt &other) const
 {
-  return mini_bdd_applyt(or_fkt)(*this, other);
+  // NOLINTNEXTLINE(build/deprecated)
+  assert(is_initialized());
+  return node->mgr->apply(mini_bdd_mgrt::opt::OR, *this, other);
+}
+
+mini_bddt mini_bdd_mgrt::apply(
+  opt op,
+  const mini_bddt &x,
+  const mini_bddt &y)
+{
+  switch(op)
+  {
+  case opt::AND: return mini_bdd_applyt(*this, op, and_fkt)(x, y);
+  case opt::OR: return mini_bdd_applyt(*this, op, or_fkt)(x, y);
+  case opt::XOR: return mini_bdd_applyt(*this, op, xor_fkt)(x, y);
+  case opt::EQUAL: return mini_bdd_applyt(*this, op, equal_fkt)(x, y);
+  }
+
+  // NOLINTNEXTLINE(build/deprecated)
+  assert(false);
+  return mini_bddt();
 }
 
-mini_bdd_mgrt::mini_bdd_mgrt()
+mini_bdd_mgrt::mini_bdd_mgrt():next_unique_id(2)
 {
   // add true/false nodes
   nodes.push_back(mini_bdd_nodet(this, 0, 0, mini_bddt(), mini_bddt()));
@@ -456,29 +517,14 @@ mini_bddt mini_bdd_mgrt::mk(
         n->high=high;
       }
 
+      n->unique_id=next_unique_id++;
+
       reverse_map[reverse_key]=n;
       return mini_bddt(n);
     }
   }
 }
 
-bool mini_bdd_mgrt::reverse_keyt::operator<(
-  const mini_bdd_mgrt::reverse_keyt &y) const
-{
-  const reverse_keyt &x=*this;
-
-  if(x.var<y.var)
-    return true;
-  else if(x.var>y.var)
-    return false;
-  else if(x.low<y.low)
-    return true;
-  else if(x.low>y.low)
-    return false;
-  else
-    return x.high<y.high;
-}
-
 void mini_bdd_mgrt::DumpTable(std::ostream &out) const
 {
   out << "\\# & \\mathit{var} & \\mathit{low} &"
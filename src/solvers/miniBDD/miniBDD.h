@@ -22,11 +22,12 @@ Author: Daniel Kroening, kroening@kroening.com
 */
 
 #include <cassert>
-#include <list>
+#include <deque>
 #include <vector>
 #include <map>
 #include <string>
 #include <stack>
+#include <unordered_map>
 
 class mini_bddt
 {
@@ -69,6 +70,9 @@ public:
   unsigned var, node_number, reference_counter;
   mini_bddt low, high;
 
+  // distinguishes the successive uses of a recycled node
+  std::size_t unique_id;
+
   mini_bdd_nodet(
     class mini_bdd_mgrt *_mgr,
     unsigned _var, unsigned _node_number,
@@ -97,12 +101,25 @@ public:
   const mini_bddt &False() const;
 
   friend class mini_bdd_nodet;
+  friend class mini_bdd_applyt;
 
   // create a node (consulting the reverse-map)
   mini_bddt mk(unsigned var, const mini_bddt &low, const mini_bddt &high);
 
   std::size_t number_of_nodes();
 
+  /// Forget all results of previous operations
+  void clear_cache()
+  {
+    computed_table.clear();
+  }
+
+  // the operations whose results are cached
+  enum class opt { AND, OR, XOR, EQUAL };
+
+  // apply a Boolean operator, consulting the computed table
+  mini_bddt apply(opt op, const mini_bddt &x, const mini_bddt &y);
+
   struct var_table_entryt
   {
     std::string label;
@@ -113,9 +130,11 @@ public:
   var_tablet var_table;
 
 protected:
-  typedef std::list<mini_bdd_nodet> nodest;
+  // a deque does not move its elements when growing at the end
+  typedef std::deque<mini_bdd_nodet> nodest;
   nodest nodes;
   mini_bddt true_bdd, false_bdd;
+  std::size_t next_unique_id;
 
   // this is our reverse-map for nodes
   struct reverse_keyt
@@ -124,14 +143,61 @@ protected:
     reverse_keyt(
       unsigned _var, const mini_bddt &_low, const mini_bddt &_high);
 
-    bool operator<(const reverse_keyt &) const;
+    bool operator==(const reverse_keyt &other) const
+    {
+      return var==other.var && low==other.low && high==other.high;
+    }
   };
 
-  typedef std::map<reverse_keyt, mini_bdd_nodet *> reverse_mapt;
+  struct reverse_key_hasht
+  {
+    std::size_t operator()(const reverse_keyt &key) const
+    {
+      return (key.var*31+key.low)*31+key.high;
+    }
+  };
+
+  typedef std::unordered_map<reverse_keyt, mini_bdd_nodet *, reverse_key_hasht>
+    reverse_mapt;
   reverse_mapt reverse_map;
 
   typedef std::stack<mini_bdd_nodet *> freet;
   freet free;
+
+  // The computed table remembers the results of operations across calls.
+  // Entries refer to nodes by their unique id and do not hold references,
+  // thus a result is only used if the node has not been freed since.
+  struct computed_keyt
+  {
+    opt op;
+    std::size_t x, y;
+
+    bool operator==(const computed_keyt &other) const
+    {
+      return op==other.op && x==other.x && y==other.y;
+    }
+  };
+
+  struct computed_key_hasht
+  {
+    std::size_t operator()(const computed_keyt &key) const
+    {
+      return (static_cast<std::size_t>(key.op)*31+key.x)*31+key.y;
+    }
+  };
+
+  struct computed_resultt
+  {
+    mini_bdd_nodet *node;
+    std::size_t unique_id;
+  };
+
+  typedef std::unordered_map<
+    computed_keyt, computed_resultt, computed_key_hasht> computed_tablet;
+  computed_tablet computed_table;
+
+  // the computed table is flushed when growing beyond this size
+  static const std::size_t computed_table_limit=1<<20;
 };
 
 mini_bddt restrict(const mini_bddt &u, unsigned var, const bool value);
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 
 #include <solvers/prop/literal.h>
 
@@ -67,6 +68,7 @@ public:
   void clear()
   {
     nodes.clear();
+    strash.clear();
   }
 
   typedef std::set<literalt::var_not> terminal_sett;
@@ -94,6 +96,7 @@ public:
   void swap(aigt &g)
   {
     nodes.swap(g.nodes);
+    strash.swap(g.strash);
   }
 
   literalt new_node()
@@ -118,6 +121,23 @@ public:
     return l;
   }
 
+  /// Returns an existing node for the conjunction of \p a and \p b
+  /// if there is one, and a new node otherwise (structural hashing).
+  /// The caller is expected to have ordered the inputs.
+  literalt hashed_and_node(literalt a, literalt b)
+  {
+    const unsigned long long key=
+      (static_cast<unsigned long long>(a.get())<<32) | b.get();
+
+    const auto entry=strash.find(key);
+    if(entry!=strash.end())
+      return entry->second;
+
+    literalt l=new_and_node(a, b);
+    strash.emplace(key, l);
+    return l;
+  }
+
   bool empty() const
   {
     return nodes.empty();
@@ -134,6 +154,10 @@ public:
   std::string dot_label(nodest::size_type v) const;
 
 protected:
+  // maps the inputs of AND nodes to the node
+  typedef std::unordered_map<unsigned long long, literalt> strasht;
+  strasht strash;
+
   const std::set<literalt::var_not> &get_terminals_rec(
     literalt::var_not n,
     terminalst &terminals) const;
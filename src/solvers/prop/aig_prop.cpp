@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <set>
 #include <stack>
+#include <utility>
 
 // Tries to compact AIGs corresponding to xor and equality
 // Needed to match the performance of the native CNF back-end.
@@ -65,7 +66,57 @@ literalt aig_prop_baset::land(literalt a, literalt b)
   if(a==b)
     return a;
 
-  return dest.new_and_node(a, b);
+  // One-level rewriting when one of the inputs is an AND node,
+  // following Brummayer/Biere, "Local Two-Level And-Inverter Graph
+  // Minimization without Blowup"
+  for(unsigned i=0; i<2; i++)
+  {
+    const literalt x=i==0?a:b;
+    const literalt y=i==0?b:a;
+
+    const aigt::nodet &node=dest.get_node(y);
+    if(!node.is_and())
+      continue;
+
+    if(!y.sign())
+    {
+      // contradiction: x & (!x & z) = false
+      if(node.a==neg(x) || node.b==neg(x))
+        return const_literal(false);
+      // idempotence: x & (x & z) = x & z
+      if(node.a==x || node.b==x)
+        return y;
+    }
+    else
+    {
+      // subsumption: x & !(!x & z) = x
+      if(node.a==neg(x) || node.b==neg(x))
+        return x;
+      // substitution: x & !(x & z) = x & !z
+      if(node.a==x)
+        return land(x, neg(node.b));
+      if(node.b==x)
+        return land(x, neg(node.a));
+    }
+  }
+
+  // contradiction: (x & y) & (!x & z) = false
+  if(!a.sign() && !b.sign())
+  {
+    const aigt::nodet &node_a=dest.get_node(a);
+    const aigt::nodet &node_b=dest.get_node(b);
+
+    if(node_a.is_and() && node_b.is_and() &&
+       (node_a.a==neg(node_b.a) || node_a.a==neg(node_b.b) ||
+        node_a.b==neg(node_b.a) || node_a.b==neg(node_b.b)))
+      return const_literal(false);
+  }
+
+  // structural hashing on normalised inputs
+  if(b.get()<a.get())
+    std::swap(a, b);
+
+  return dest.hashed_and_node(a, b);
 }
 
 literalt aig_prop_baset::lor(literalt a, literalt b)
@@ -144,9 +195,68 @@ void aig_prop_baset::set_equal(literalt a, literalt b)
 #endif
 }
 
+/// The CNF does not constrain the variables of gates that are inlined or
+/// encoded in one polarity only, so the values of gates are computed from
+/// the values of the inputs in the model.
 tvt aig_prop_solvert::l_get(literalt a) const
 {
-  return solver.l_get(a);
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  const tvt value=node_value(a.var_no());
+  return a.sign()?!value:value;
+}
+
+tvt aig_prop_solvert::node_value(unsigned n) const
+{
+  if(node_values.size()<aig.nodes.size())
+    node_values.resize(aig.nodes.size());
+
+  if(!node_values[n].is_unknown())
+    return node_values[n];
+
+  // evaluate the cone of n, inputs first
+  std::stack<unsigned> stack;
+  stack.push(n);
+
+  while(!stack.empty())
+  {
+    const unsigned m=stack.top();
+    const aigt::nodet &node=aig.nodes[m];
+
+    if(!node_values[m].is_unknown())
+      stack.pop();
+    else if(node.is_var())
+    {
+      node_values[m]=solver.l_get(literalt(m, false));
+      stack.pop();
+
+      // inputs that the solver does not know are unconstrained
+      if(node_values[m].is_unknown())
+        node_values[m]=tvt(false);
+    }
+    else
+    {
+      const literalt inputs[]={ node.a, node.b };
+      bool ready=true;
+
+      for(const literalt &input : inputs)
+        if(!input.is_constant() &&
+           node_values[input.var_no()].is_unknown())
+        {
+          stack.push(input.var_no());
+          ready=false;
+        }
+
+      if(ready)
+      {
+        node_values[m]=l_get(node.a) && l_get(node.b);
+        stack.pop();
+      }
+    }
+  }
+
+  return node_values[n];
 }
 
 propt::resultt aig_prop_solvert::prop_solve()
@@ -154,6 +264,7 @@ propt::resultt aig_prop_solvert::prop_solve()
   status() << "converting AIG, "
            << aig.nodes.size() << " nodes" << eom;
   convert_aig();
+  node_values.clear();
 
   return solver.prop_solve();
 }
@@ -224,9 +335,11 @@ void aig_prop_solvert::compute_phase(
 
 
 /// Compact encoding for single usage variable
-/// \par parameters: Two vectors of unsigned of size aig.nodes.size()
+/// \par parameters: The nodes that are relevant for the constraints, and
+///   two vectors of unsigned of size aig.nodes.size()
 /// \return These vectors filled in with per node usage information
 void aig_prop_solvert::usage_count(
+  const std::vector<bool> &live,
   std::vector<unsigned> &p_usage_count,
   std::vector<unsigned> &n_usage_count)
 {
@@ -252,7 +365,9 @@ void aig_prop_solvert::usage_count(
   {
     const aigt::nodet &node=aig.nodes[n];
 
-    if(node.is_and())
+    // uses by nodes that no constraint depends on would only block
+    // inlining, as no clauses are generated for them
+    if(node.is_and() && live[n])
     {
       if(node.a.sign())
       {
@@ -554,15 +669,7 @@ void aig_prop_solvert::convert_aig()
   while(solver.no_variables()<=aig.nodes.size())
     solver.new_variable();
 
-  // Usage count for inlining
-
-  std::vector<unsigned> p_usage_count;
-  std::vector<unsigned> n_usage_count;
-  p_usage_count.resize(aig.nodes.size(), 0);
-  n_usage_count.resize(aig.nodes.size(), 0);
-
-  this->usage_count(p_usage_count, n_usage_count);
-
+  std::vector<bool> live;
 
   #ifdef USE_PG
   // Get phases
@@ -571,8 +678,23 @@ void aig_prop_solvert::convert_aig()
   n_neg.resize(aig.nodes.size(), false);
 
   this->compute_phase(n_pos, n_neg);
+
+  live.resize(aig.nodes.size());
+  for(std::size_t n=0; n<aig.nodes.size(); n++)
+    live[n]=n_pos[n] || n_neg[n];
+  #else
+  live.resize(aig.nodes.size(), true);
   #endif
 
+  // Usage count for inlining
+
+  std::vector<unsigned> p_usage_count;
+  std::vector<unsigned> n_usage_count;
+  p_usage_count.resize(aig.nodes.size(), 0);
+  n_usage_count.resize(aig.nodes.size(), 0);
+
+  this->usage_count(live, p_usage_count, n_usage_count);
+
   // 2. Do nodes
   for(std::size_t n=aig.nodes.size() - 1; n!=0; n--)
   {
@@ -593,6 +715,5 @@ void aig_prop_solvert::convert_aig()
   for(const auto &c_it : aig.constraints)
     solver.l_set_to(c_it, true);
 
-  // HACK!
-  aig.nodes.clear();
+  // the nodes are kept, as l_get evaluates the gates on the model
 }
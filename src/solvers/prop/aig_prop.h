@@ -45,6 +45,10 @@ public:
 
   literalt new_variable() override
   {
+    // variable number 0 is taken by the constants
+    if(dest.number_of_nodes()==0)
+      dest.new_node();
+
     return dest.new_node();
   }
 
@@ -117,9 +121,16 @@ public:
 protected:
   propt &solver;
 
+  // the values of the nodes in the last model, computed on demand
+  mutable std::vector<tvt> node_values;
+
+  tvt node_value(unsigned n) const;
+
   void convert_aig();
   void usage_count(
-    std::vector<unsigned> &p_usage_count, std::vector<unsigned> &n_usage_count);
+    const std::vector<bool> &live,
+    std::vector<unsigned> &p_usage_count,
+    std::vector<unsigned> &n_usage_count);
   void compute_phase(std::vector<bool> &n_pos, std::vector<bool> &n_neg);
   void convert_node(
     unsigned n,
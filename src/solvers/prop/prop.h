@@ -91,6 +91,9 @@ public:
   virtual size_t no_variables() const=0;
   bvt new_variables(std::size_t width);
 
+  // clauses added so far, if the solver counts them
+  virtual size_t no_clauses() const { return 0; }
+
   // solving
   virtual const std::string solver_text()=0;
   enum class resultt { P_SATISFIABLE, P_UNSATISFIABLE, P_ERROR };
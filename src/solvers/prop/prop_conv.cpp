@@ -480,8 +480,9 @@ void prop_conv_solvert::post_process()
 
 decision_proceduret::resultt prop_conv_solvert::dec_solve()
 {
-  // post-processing isn't incremental yet
-  if(!post_processing_done)
+  // when repeated, post-processing only adds the constraints for what was
+  // converted since the last call
+  if(!post_processing_done || repeat_post_processing)
   {
     statistics() << "Post-processing" << eom;
     post_process();
@@ -58,6 +58,10 @@ public:
 
   // Resource limits:
   virtual void set_time_limit_seconds(uint32_t) {}
+
+  // size of the encoding so far, for statistics
+  virtual std::size_t get_number_of_variables() const { return 0; }
+  virtual std::size_t get_number_of_clauses() const { return 0; }
 };
 
 //
@@ -75,6 +79,7 @@ public:
     use_cache(true),
     equality_propagation(true),
     freeze_all(false),
+    repeat_post_processing(false),
     post_processing_done(false),
     prop(_prop) { }
 
@@ -109,6 +114,9 @@ public:
   bool use_cache;
   bool equality_propagation;
   bool freeze_all; // freezing variables (for incremental solving)
+  // post-process before every solver call, for formulas that grow
+  // between calls
+  bool repeat_post_processing;
 
   virtual void clear_cache() { cache.clear();}
 
@@ -123,6 +131,16 @@ public:
     prop.set_time_limit_seconds(lim);
   }
 
+  std::size_t get_number_of_variables() const override
+  {
+    return prop.no_variables();
+  }
+
+  std::size_t get_number_of_clauses() const override
+  {
+    return prop.no_clauses();
+  }
+
 protected:
   virtual void post_process();
 
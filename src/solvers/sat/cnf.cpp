@@ -270,6 +270,20 @@ literalt cnft::land(literalt a, literalt b)
     return a;
   if(a==b)
     return a;
+  if(a==!b)
+    return const_literal(false);
+
+  if(structural_hashing)
+  {
+    if(b.get()<a.get())
+      std::swap(a, b);
+
+    bool is_new;
+    literalt o=hashed_gate(gate_kindt::AND, a, b, literalt(), 3, is_new);
+    if(is_new)
+      gate_and(a, b, o);
+    return o;
+  }
 
   literalt o=new_variable();
   gate_and(a, b, o);
@@ -286,6 +300,13 @@ literalt cnft::lor(literalt a, literalt b)
     return a;
   if(a==b)
     return a;
+  if(a==!b)
+    return const_literal(true);
+
+  // a OR b = NOT(NOT a AND NOT b), and the Tseitin clauses coincide,
+  // so OR gates share the table with AND gates
+  if(structural_hashing)
+    return !land(!a, !b);
 
   literalt o=new_variable();
   gate_or(a, b, o);
@@ -309,6 +330,22 @@ literalt cnft::lxor(literalt a, literalt b)
   if(a==!b)
     return const_literal(true);
 
+  if(structural_hashing)
+  {
+    // negated inputs only flip the output
+    const bool negate=a.sign()!=b.sign();
+    a=literalt(a.var_no(), false);
+    b=literalt(b.var_no(), false);
+    if(b.get()<a.get())
+      std::swap(a, b);
+
+    bool is_new;
+    literalt o=hashed_gate(gate_kindt::XOR, a, b, literalt(), 4, is_new);
+    if(is_new)
+      gate_xor(a, b, o);
+    return negate?!o:o;
+  }
+
   literalt o=new_variable();
   gate_xor(a, b, o);
   return o;
@@ -360,9 +397,31 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
 
   // (a+c'+o) (a+c+o') (a'+b'+o) (a'+b+o')
 
-  literalt o=new_variable();
+  literalt o;
+  bool negate=false;
 
-  bvt lits;
+  if(structural_hashing)
+  {
+    // !a?b:c = a?c:b and a?!b:!c = !(a?b:c)
+    if(a.sign())
+    {
+      a=!a;
+      std::swap(b, c);
+    }
+    if(b.sign())
+    {
+      negate=true;
+      b=!b;
+      c=!c;
+    }
+
+    bool is_new;
+    o=hashed_gate(gate_kindt::ITE, a, b, c, 4, is_new);
+    if(!is_new)
+      return negate?!o:o;
+  }
+  else
+    o=new_variable();
 
   lcnf(a, !c,  o);
   lcnf(a,  c, !o);
@@ -375,13 +434,47 @@ literalt cnft::lselect(literalt a, literalt b, literalt c)
   lcnf(!b, !c,  o);
   #endif
 
-  return o;
+  return negate?!o:o;
 
   #else
   return lor(land(a, b), land(!a, c));
   #endif
 }
 
+/// Look up a gate with normalised inputs in the structural hash table
+/// \param kind: type of the gate
+/// \param a: first input
+/// \param b: second input
+/// \param c: third input, only used for if-then-else
+/// \param no_clauses: number of clauses that encode the gate
+/// \param [out] is_new: set to true iff the caller needs to generate the
+///   clauses for the returned output literal
+/// \return Output signal of the gate as literal
+literalt cnft::hashed_gate(
+  gate_kindt kind,
+  literalt a,
+  literalt b,
+  literalt c,
+  unsigned no_clauses,
+  bool &is_new)
+{
+  const gate_keyt key{kind, a.get(), b.get(), c.get()};
+
+  auto entry=gate_cache.find(key);
+  if(entry!=gate_cache.end())
+  {
+    is_new=false;
+    _no_hashed_gates++;
+    _no_hashed_clauses+=no_clauses;
+    return entry->second;
+  }
+
+  is_new=true;
+  literalt o=new_variable();
+  gate_cache.emplace(key, o);
+  return o;
+}
+
 /// Generate a new variable and return it as a literal
 /// \return New variable as literal
 literalt cnft::new_variable()
@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_CNF_H
 #define CPROVER_SOLVERS_SAT_CNF_H
 
+#include <unordered_map>
+
 #include <solvers/prop/prop.h>
 
 class cnft:public propt
@@ -19,7 +21,13 @@ class cnft:public propt
 public:
   // For CNF, we don't use index 0 as a matter of principle,
   // so we'll start counting variables at 1.
-  cnft():_no_variables(1) { }
+  cnft():
+    _no_variables(1),
+    structural_hashing(false),
+    _no_hashed_gates(0),
+    _no_hashed_clauses(0)
+  {
+  }
   virtual ~cnft() { }
 
   virtual literalt land(literalt a, literalt b) override;
@@ -37,7 +45,7 @@ public:
   virtual literalt new_variable() override;
   virtual size_t no_variables() const override { return _no_variables; }
   virtual void set_no_variables(size_t no) { _no_variables=no; }
-  virtual size_t no_clauses() const=0;
+  virtual size_t no_clauses() const override=0;
 
   void gate_and(literalt a, literalt b, literalt o);
   void gate_or(literalt a, literalt b, literalt o);
@@ -49,9 +57,70 @@ public:
 
   static bvt eliminate_duplicates(const bvt &);
 
+  /// Reuse the output of a previously generated two-input gate or
+  /// if-then-else when the same gate, modulo commutativity and negation,
+  /// is requested again.
+  void set_structural_hashing(bool value)
+  {
+    structural_hashing=value;
+    if(!structural_hashing)
+      clear_gate_cache();
+  }
+
+  /// Forget all gates seen so far; needs to be called whenever the
+  /// back-end may have eliminated gate outputs, e.g., by pre-processing
+  /// during a call to the solver.
+  void clear_gate_cache() { gate_cache.clear(); }
+
+  /// Number of gates that were not generated due to structural hashing
+  size_t no_hashed_gates() const { return _no_hashed_gates; }
+
+  /// Number of clauses that were not generated due to structural hashing
+  size_t no_hashed_clauses() const { return _no_hashed_clauses; }
+
 protected:
   size_t _no_variables;
 
+  bool structural_hashing;
+  size_t _no_hashed_gates, _no_hashed_clauses;
+
+  enum class gate_kindt { AND, XOR, ITE };
+
+  struct gate_keyt
+  {
+    gate_kindt kind;
+    literalt::var_not a, b, c;
+
+    bool operator==(const gate_keyt &other) const
+    {
+      return kind==other.kind && a==other.a && b==other.b && c==other.c;
+    }
+  };
+
+  struct gate_key_hasht
+  {
+    std::size_t operator()(const gate_keyt &key) const
+    {
+      std::size_t h=static_cast<std::size_t>(key.kind);
+      h=h*31+key.a;
+      h=h*31+key.b;
+      h=h*31+key.c;
+      return h;
+    }
+  };
+
+  typedef std::unordered_map<gate_keyt, literalt, gate_key_hasht>
+    gate_cachet;
+  gate_cachet gate_cache;
+
+  literalt hashed_gate(
+    gate_kindt kind,
+    literalt a,
+    literalt b,
+    literalt c,
+    unsigned no_clauses,
+    bool &is_new);
+
   bool process_clause(const bvt &bv, bvt &dest);
 
   static bool is_all(const bvt &bv, literalt l)
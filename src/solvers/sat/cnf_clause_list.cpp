@@ -16,12 +16,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 void cnf_clause_listt::lcnf(const bvt &bv)
 {
-  bvt new_bv;
-
-  if(process_clause(bv, new_bv))
+  // re-use the buffer to avoid an allocation per clause
+  if(process_clause(bv, clause_buffer))
     return;
 
-  clauses.push_back(new_bv);
+  clauses.push_back(clause_buffer);
 }
 
 void cnf_clause_list_assignmentt::print_assignment(std::ostream &out) const
@@ -12,12 +12,140 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_CNF_CLAUSE_LIST_H
 #define CPROVER_SOLVERS_SAT_CNF_CLAUSE_LIST_H
 
-#include <list>
+#include <cstddef>
+#include <iterator>
+#include <vector>
 
 #include <util/threeval.h>
 
 #include "cnf.h"
 
+/// Stores clauses back-to-back in a single vector of literals, with
+/// the start of each clause recorded in a vector of offsets. This
+/// avoids one heap allocation per clause.
+class clause_arenat
+{
+public:
+  /// A read-only view on one clause in the arena
+  class clauset
+  {
+  public:
+    clauset(const literalt *_begin, const literalt *_end):
+      _begin(_begin), _end(_end)
+    {
+    }
+
+    typedef const literalt *const_iterator;
+    const_iterator begin() const { return _begin; }
+    const_iterator end() const { return _end; }
+    std::size_t size() const { return _end-_begin; }
+    bool empty() const { return _begin==_end; }
+    const literalt &operator[](std::size_t i) const { return _begin[i]; }
+
+    // NOLINTNEXTLINE(runtime/explicit)
+    operator bvt() const { return bvt(_begin, _end); }
+
+  protected:
+    const literalt *_begin, *_end;
+  };
+
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef clauset value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const clauset *pointer;
+    typedef clauset reference;
+
+    const_iterator(const clause_arenat &_arena, std::size_t _index):
+      arena(&_arena), index(_index)
+    {
+    }
+
+    clauset operator*() const { return (*arena)[index]; }
+
+    // clauses are created on the fly, so we hand out a proxy
+    struct pointert
+    {
+      clauset clause;
+      const clauset *operator->() const { return &clause; }
+    };
+
+    pointert operator->() const { return pointert{**this}; }
+
+    const_iterator &operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp=*this;
+      ++index;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return index==other.index;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return index!=other.index;
+    }
+
+  protected:
+    const clause_arenat *arena;
+    std::size_t index;
+  };
+
+  typedef const_iterator iterator;
+
+  clause_arenat():offsets(1, 0)
+  {
+  }
+
+  void push_back(const bvt &clause)
+  {
+    literals.insert(literals.end(), clause.begin(), clause.end());
+    offsets.push_back(literals.size());
+  }
+
+  clauset operator[](std::size_t i) const
+  {
+    const literalt *base=literals.data();
+    return clauset(base+offsets[i], base+offsets[i+1]);
+  }
+
+  std::size_t size() const { return offsets.size()-1; }
+  bool empty() const { return size()==0; }
+
+  /// Total number of literals in all clauses
+  std::size_t number_of_literals() const { return literals.size(); }
+
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, size()); }
+
+  void clear()
+  {
+    literals.clear();
+    offsets.resize(1);
+  }
+
+  bool operator==(const clause_arenat &other) const
+  {
+    return literals==other.literals && offsets==other.offsets;
+  }
+
+protected:
+  std::vector<literalt> literals;
+  // clause i occupies literals[offsets[i]] to literals[offsets[i+1]-1]
+  std::vector<std::size_t> offsets;
+};
+
 // CNF given as a list of clauses
 
 class cnf_clause_listt:public cnft
@@ -40,7 +168,7 @@ public:
 
   virtual size_t no_clauses() const { return clauses.size(); }
 
-  typedef std::list<bvt> clausest;
+  typedef clause_arenat clausest;
 
   clausest &get_clauses() { return clauses; }
 
@@ -54,11 +182,12 @@ public:
       cnf.lcnf(*it);
   }
 
-  static size_t hash_clause(const bvt &bv)
+  template<typename clauseT>
+  static size_t hash_clause(const clauseT &bv)
   {
     size_t result=0;
-    for(bvt::const_iterator it=bv.begin(); it!=bv.end(); it++)
-      result=((result<<2)^it->get())-result;
+    for(const auto &l : bv)
+      result=((result<<2)^l.get())-result;
 
     return result;
   }
@@ -74,6 +203,7 @@ public:
 
 protected:
   clausest clauses;
+  bvt clause_buffer;
 };
 
 // CNF given as a list of clauses
@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "dimacs_cnf.h"
 
 #include <iostream>
+#include <string>
 
 dimacs_cnft::dimacs_cnft():break_lines(false)
 {
@@ -32,9 +33,31 @@ void dimacs_cnft::write_problem_line(std::ostream &out)
       << clauses.size() << "\n";
 }
 
+/// Append the decimal representation of \p value to \p dest; this is
+/// considerably faster than formatting via an ostream.
+static void append_int(std::string &dest, int value)
+{
+  char buffer[12];
+  char *p=buffer+sizeof(buffer);
+  unsigned u=value<0?0u-static_cast<unsigned>(value):value;
+
+  do
+  {
+    *--p='0'+u%10;
+    u/=10;
+  }
+  while(u!=0);
+
+  if(value<0)
+    *--p='-';
+
+  dest.append(p, buffer+sizeof(buffer));
+}
+
+template<typename clauseT>
 static void write_dimacs_clause(
-  const bvt &clause,
-  std::ostream &out,
+  const clauseT &clause,
+  std::string &dest,
   bool break_lines)
 {
   // The DIMACS CNF format allows line breaks in clauses:
@@ -49,23 +72,40 @@ static void write_dimacs_clause(
 
   for(size_t j=0; j<clause.size(); j++)
   {
-    out << clause[j].dimacs() << " ";
+    append_int(dest, clause[j].dimacs());
+    dest+=' ';
     // newline to avoid overflow in sat checkers
     if((j&15)==0 && j!=0 && break_lines)
-      out << "\n";
+      dest+='\n';
   }
 
-  out << "0" << "\n";
+  dest+="0\n";
 }
 
 void dimacs_cnft::write_clauses(std::ostream &out)
 {
-  for(clausest::const_iterator it=clauses.begin();
-      it!=clauses.end(); it++)
-    write_dimacs_clause(*it, out, break_lines);
+  // format into a buffer that is flushed in large blocks
+  const std::size_t flush_size=1<<16;
+  std::string buffer;
+  buffer.reserve(flush_size+256);
+
+  for(const auto &clause : clauses)
+  {
+    write_dimacs_clause(clause, buffer, break_lines);
+
+    if(buffer.size()>=flush_size)
+    {
+      out.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+
+  out.write(buffer.data(), buffer.size());
 }
 
 void dimacs_cnf_dumpt::lcnf(const bvt &bv)
 {
-  write_dimacs_clause(bv, out, true);
+  std::string buffer;
+  write_dimacs_clause(bv, buffer, true);
+  out << buffer;
 }
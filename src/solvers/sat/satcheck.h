@@ -31,6 +31,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #define SATCHECK_ZCHAFF
 #endif
 
+// the build system calls zChaff "CHAFF"
+#if (defined(HAVE_CHAFF) || defined(SATCHECK_CHAFF)) && \
+    !defined(SATCHECK_ZCHAFF)
+#define SATCHECK_ZCHAFF
+#endif
+
 #if defined(HAVE_MINISAT1) && !defined(SATCHECK_MINISAT1)
 #define SATCHECK_MINISAT1
 #endif
@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cassert>
 #include <stack>
+#include <type_traits>
 
 #include <util/threeval.h>
 
@@ -123,6 +124,17 @@ propt::resultt satcheck_glucose_baset<T>::prop_solve()
       solver->nClauses() << " clauses" << eom;
   }
 
+  if(no_hashed_gates()!=0)
+  {
+    messaget::statistics() <<
+      "Structural hashing: " << no_hashed_gates() << " gates and " <<
+      no_hashed_clauses() << " clauses saved" << eom;
+  }
+
+  // the simplifier may eliminate gate outputs that are not frozen
+  if(std::is_same<T, Glucose::SimpSolver>::value)
+    clear_gate_cache();
+
   add_variables();
 
   if(!solver->okay())
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cassert>
 #include <stack>
+#include <type_traits>
 
 #include <util/invariant.h>
 #include <util/threeval.h>
@@ -137,6 +138,17 @@ propt::resultt satcheck_minisat2_baset<T>::prop_solve()
       solver->nClauses() << " clauses" << eom;
   }
 
+  if(no_hashed_gates()!=0)
+  {
+    messaget::statistics() <<
+      "Structural hashing: " << no_hashed_gates() << " gates and " <<
+      no_hashed_clauses() << " clauses saved" << eom;
+  }
+
+  // the simplifier may eliminate gate outputs that are not frozen
+  if(std::is_same<T, Minisat::SimpSolver>::value)
+    clear_gate_cache();
+
   try
   {
     add_variables();
@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "satcheck_zchaff.h"
 
 #include <cassert>
+#include <vector>
 
 #include <zchaff_solver.h>
 
@@ -61,11 +62,17 @@ void satcheck_zchaff_baset::copy_cnf()
   // this can only be called once
   solver->set_variable_number(no_variables());
 
-  for(clausest::const_iterator it=clauses.begin();
-      it!=clauses.end();
-      it++)
-    solver->add_orig_clause(
-      reinterpret_cast<int*>(&((*it)[0])), it->size());
+  // zChaff takes non-const arrays of literals in the encoding of literalt
+  std::vector<int> literals;
+
+  for(const auto &clause : clauses)
+  {
+    literals.clear();
+    for(const auto &l : clause)
+      literals.push_back(l.get());
+
+    solver->add_orig_clause(literals.data(), literals.size());
+  }
 }
 
 propt::resultt satcheck_zchaff_baset::prop_solve()
@@ -140,18 +147,18 @@ propt::resultt satcheck_zchaff_baset::prop_solve()
   if(result==UNSATISFIABLE)
   {
     status=UNSAT;
-    return P_UNSATISFIABLE;
+    return resultt::P_UNSATISFIABLE;
   }
 
   if(result==SATISFIABLE)
   {
     status=SAT;
-    return P_SATISFIABLE;
+    return resultt::P_SATISFIABLE;
   }
 
   status=ERROR;
 
-  return P_ERROR;
+  return resultt::P_ERROR;
 }
 
 void satcheck_zchaff_baset::set_assignment(literalt a, bool value)
@@ -80,7 +80,7 @@ propt::resultt satcheck_zcoret::prop_solve()
 
         while(true)
         {
-          int l=unsafe_str2int(p);
+          int l=unsafe_string2int(p);
           if(l==0)
             break;
 
@@ -101,12 +101,12 @@ propt::resultt satcheck_zcoret::prop_solve()
   }
 
   if(in_core.empty())
-    return P_ERROR;
+    return resultt::P_ERROR;
 
   remove(cnf_file.c_str());
   // remove(core_file.c_str());
   remove(trace_file.c_str());
   // remove(output_file.c_str());
 
-  return P_UNSATISFIABLE;
+  return resultt::P_UNSATISFIABLE;
 }
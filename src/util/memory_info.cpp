@@ -21,6 +21,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifdef _WIN32
 #include <windows.h>
 #include <psapi.h>
+#else
+#include <sys/resource.h>
 #endif
 
 #include <ostream>
@@ -69,3 +71,21 @@ void memory_info(std::ostream &out)
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
   #endif
 }
+
+std::size_t peak_memory_usage()
+{
+  #ifdef _WIN32
+  // as above, this would require linking psapi
+  return 0;
+  #else
+  struct rusage usage; // NOLINT(readability/identifiers)
+  if(getrusage(RUSAGE_SELF, &usage)!=0)
+    return 0;
+  #ifdef __APPLE__
+  return usage.ru_maxrss;
+  #else
+  // kilobytes
+  return static_cast<std::size_t>(usage.ru_maxrss)*1024;
+  #endif
+  #endif
+}
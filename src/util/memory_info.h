@@ -10,8 +10,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_MEMORY_INFO_H
 #define CPROVER_UTIL_MEMORY_INFO_H
 
+#include <cstddef>
 #include <iosfwd>
 
 void memory_info(std::ostream &);
 
+/// \return the peak resident set size of the process in bytes, or zero
+///   if it is not known
+std::size_t peak_memory_usage();
+
 #endif // CPROVER_UTIL_MEMORY_INFO_H
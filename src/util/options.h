@@ -43,6 +43,11 @@ public:
     option_map[option]=values;
   }
 
+  const option_mapt &get_option_map() const
+  {
+    return option_map;
+  }
+
   optionst() { }
   ~optionst() { }
 
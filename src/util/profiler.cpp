@@ -0,0 +1,159 @@
+/*******************************************************************\
+
+Module: Phase-Level Profiling
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Phase-Level Profiling
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "irep.h"
+#include "memory_info.h"
+
+profilert profiler;
+
+void profilert::enable()
+{
+  enabled=true;
+  start=std::chrono::steady_clock::now();
+  peak_memory_at_start=peak_memory_usage();
+}
+
+/// \return the child `name` of the innermost running phase, which is
+///   added if there is none yet
+profilert::phaset &profilert::current_child(const std::string &name)
+{
+  std::list<phaset> &children=current->children;
+  std::list<phaset>::iterator phase=
+    std::find_if(
+      children.begin(),
+      children.end(),
+      [&name](const phaset &p) { return p.name==name; });
+
+  if(phase==children.end())
+  {
+    children.push_back(phaset());
+    phase=--children.end();
+    phase->name=name;
+    phase->parent=current;
+  }
+
+  return *phase;
+}
+
+profilert::scopet::scopet(
+  profilert &_profiler,
+  const std::string &name):
+  profiler(_profiler),
+  active(_profiler.enabled)
+{
+  if(!active)
+    return;
+
+  profiler.current=&profiler.current_child(name);
+  peak_memory_at_start=peak_memory_usage();
+  start=std::chrono::steady_clock::now();
+}
+
+profilert::scopet::~scopet()
+{
+  if(!active)
+    return;
+
+  phaset &phase=*profiler.current;
+  ++phase.calls;
+  phase.time+=std::chrono::steady_clock::now()-start;
+  phase.peak_memory_growth+=peak_memory_usage()-peak_memory_at_start;
+
+  profiler.current=phase.parent;
+}
+
+void profilert::set_counter(const std::string &name, std::size_t value)
+{
+  if(enabled)
+    current->counters[name]=value;
+}
+
+void profilert::add_time(
+  const std::string &name,
+  std::chrono::steady_clock::duration time,
+  std::size_t pieces)
+{
+  if(!enabled)
+    return;
+
+  phaset &phase=current_child(name);
+  phase.calls+=pieces;
+  phase.time+=time;
+}
+
+void profilert::output(const phaset &phase, json_objectt &dest)
+{
+  dest["name"]=json_stringt(phase.name);
+  dest["calls"]=json_numbert(std::to_string(phase.calls));
+  dest["time"]=
+    json_numbert(
+      std::to_string(std::chrono::duration<double>(phase.time).count()));
+  dest["peakMemoryGrowth"]=
+    json_numbert(std::to_string(phase.peak_memory_growth));
+
+  if(!phase.counters.empty())
+  {
+    json_objectt &counters=dest["counters"].make_object();
+    for(const auto &counter : phase.counters)
+      counters[counter.first]=json_numbert(std::to_string(counter.second));
+  }
+
+  if(!phase.children.empty())
+  {
+    json_arrayt &children=dest["phases"].make_array();
+    for(const auto &child : phase.children)
+      output(child, children.push_back().make_object());
+  }
+}
+
+json_objectt profilert::to_json()
+{
+  if(enabled)
+  {
+    root.calls=1;
+    root.time=std::chrono::steady_clock::now()-start;
+    root.peak_memory_growth=peak_memory_usage()-peak_memory_at_start;
+    root.counters["peakMemory"]=peak_memory_usage();
+  }
+
+  json_objectt json;
+  output(root, json);
+  return json;
+}
+
+void irep_node_countert::operator()(const irept &irep)
+{
+  // iterative, as expressions may be deeply nested
+  std::vector<const irept *> stack(1, &irep);
+
+  while(!stack.empty())
+  {
+    const irept &node=*stack.back();
+    stack.pop_back();
+
+    if(!nodes.insert(&node.read()).second)
+      continue;
+
+    for(const auto &sub : node.get_sub())
+      stack.push_back(&sub);
+
+    for(const auto &named_sub : node.get_named_sub())
+      stack.push_back(&named_sub.second);
+
+    for(const auto &comment : node.get_comments())
+      stack.push_back(&comment.second);
+  }
+}
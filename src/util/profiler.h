@@ -0,0 +1,129 @@
+/*******************************************************************\
+
+Module: Phase-Level Profiling
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Phase-Level Profiling
+///
+/// Phases are timed by scopes, which nest: a phase entered while another
+/// one is running becomes its child. Entering a phase with the same name
+/// under the same parent again adds to the existing entry. For each phase
+/// the number of calls, the wall-clock time and the growth of the peak
+/// resident set size are recorded, together with any counters set while
+/// it is running. Phases must be entered and left by the main thread.
+
+#ifndef CPROVER_UTIL_PROFILER_H
+#define CPROVER_UTIL_PROFILER_H
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_set>
+
+#include "json.h"
+
+class irept;
+
+class profilert
+{
+public:
+  profilert():
+    enabled(false),
+    current(&root)
+  {
+    root.name="total";
+  }
+
+  void enable();
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  /// Times the phase `name` while it exists, if the profiler is enabled
+  class scopet
+  {
+  public:
+    scopet(profilert &_profiler, const std::string &name);
+    ~scopet();
+
+    scopet(const scopet &)=delete;
+    scopet &operator=(const scopet &)=delete;
+
+  protected:
+    profilert &profiler;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+    std::size_t peak_memory_at_start;
+  };
+
+  /// Sets a counter of the innermost running phase
+  void set_counter(const std::string &name, std::size_t value);
+
+  /// Adds `time` to the phase `name` below the innermost running phase,
+  /// for phases that are measured in `pieces` rather than by a scope;
+  /// the pieces count as calls
+  void add_time(
+    const std::string &name,
+    std::chrono::steady_clock::duration time,
+    std::size_t pieces);
+
+  /// Stops the timing of the whole run and returns all phases
+  json_objectt to_json();
+
+protected:
+  struct phaset
+  {
+    phaset():
+      parent(nullptr),
+      calls(0),
+      time(std::chrono::steady_clock::duration::zero()),
+      peak_memory_growth(0)
+    {
+    }
+
+    std::string name;
+    phaset *parent;
+    std::size_t calls;
+    std::chrono::steady_clock::duration time;
+    std::size_t peak_memory_growth;
+    std::map<std::string, std::size_t> counters;
+    std::list<phaset> children;
+  };
+
+  bool enabled;
+  phaset root;
+  phaset *current;
+  std::chrono::steady_clock::time_point start;
+  std::size_t peak_memory_at_start;
+
+  phaset &current_child(const std::string &name);
+
+  static void output(const phaset &phase, json_objectt &dest);
+};
+
+/// Counts the distinct irep nodes in the ireps passed to it
+class irep_node_countert
+{
+public:
+  void operator()(const irept &irep);
+
+  std::size_t count() const
+  {
+    return nodes.size();
+  }
+
+protected:
+  std::unordered_set<const void *> nodes;
+};
+
+// an ugly global object
+extern profilert profiler;
+
+#endif // CPROVER_UTIL_PROFILER_H
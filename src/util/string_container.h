@@ -73,6 +73,12 @@ public:
     return *string_vector[no];
   }
 
+  // the number of strings stored
+  size_t size() const
+  {
+    return string_vector.size();
+  }
+
 protected:
   // the 'unsigned' ought to be size_t
   typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+ Module: Unit tests for sparse state storage in ait
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for sparse state storage in ait
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/interval_state.h>
+
+#include <analyses/interval_domain.h>
+
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+SCENARIO(
+  "ait with sparse storage computes the same states",
+  "[core][analyses][ai]")
+{
+  symbol_tablet symbol_table;
+  const signedbv_typet int_type(32);
+
+  for(const char *name : { "x", "y" })
+  {
+    symbolt symbol;
+    symbol.name=name;
+    symbol.base_name=name;
+    symbol.type=int_type;
+    symbol.is_lvalue=true;
+    symbol_table.add(symbol);
+  }
+
+  const namespacet ns(symbol_table);
+  const symbol_exprt x("x", int_type);
+  const symbol_exprt y("y", int_type);
+
+  GIVEN("A loop with a straight-line body")
+  {
+    // x=0; y=0;
+    // head: if(!(x<10)) goto end;
+    //   x=x+1; y=x; y=y+2;
+    //   goto head;
+    // end: y=y+x;
+    goto_programt program;
+
+    goto_programt::targett i=program.add_instruction(ASSIGN);
+    i->code=code_assignt(x, from_integer(0, int_type));
+    i=program.add_instruction(ASSIGN);
+    i->code=code_assignt(y, from_integer(0, int_type));
+
+    goto_programt::targett head=program.add_instruction(GOTO);
+    head->guard=not_exprt(
+      binary_relation_exprt(x, ID_lt, from_integer(10, int_type)));
+
+    i=program.add_instruction(ASSIGN);
+    i->code=code_assignt(x, plus_exprt(x, from_integer(1, int_type)));
+    i=program.add_instruction(ASSIGN);
+    i->code=code_assignt(y, x);
+    i=program.add_instruction(ASSIGN);
+    i->code=code_assignt(y, plus_exprt(y, from_integer(2, int_type)));
+    i=program.add_instruction(GOTO);
+    i->targets.push_back(head);
+
+    goto_programt::targett end=program.add_instruction(ASSIGN);
+    end->code=code_assignt(y, plus_exprt(y, x));
+    head->targets.push_back(end);
+    program.add_instruction(END_FUNCTION);
+    program.update();
+
+    ait<interval_domaint> dense;
+    dense(program, ns);
+
+    WHEN("The analysis keeps states only at branches and joins")
+    {
+      ait<interval_domaint> sparse;
+      sparse.set_sparse_storage(2);
+      sparse(program, ns);
+
+      THEN("Every location has the same state as with full storage")
+      {
+        forall_goto_program_instructions(it, program)
+          REQUIRE(state_string(sparse, it, ns)==state_string(dense, it, ns));
+      }
+
+      THEN("Locations are also recomputed in reverse order")
+      {
+        std::vector<goto_programt::const_targett> locations;
+        forall_goto_program_instructions(it, program)
+          locations.push_back(it);
+
+        for(auto it=locations.rbegin(); it!=locations.rend(); ++it)
+          REQUIRE(
+            state_string(sparse, *it, ns)==state_string(dense, *it, ns));
+      }
+    }
+  }
+}
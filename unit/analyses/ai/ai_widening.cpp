@@ -0,0 +1,119 @@
+/*******************************************************************\
+
+ Module: Unit tests for widening and narrowing in widening_ait
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for widening and narrowing in widening_ait
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/interval_state.h>
+
+#include <analyses/interval_domain.h>
+
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+/// x=0; while(x<bound) x=x+step; y=x;
+static goto_programt::const_targett make_loop(
+  goto_functionst &goto_functions,
+  const symbol_exprt &x,
+  const symbol_exprt &y,
+  int bound,
+  int step)
+{
+  goto_functionst::goto_functiont &main=
+    goto_functions.function_map[goto_functions.entry_point()];
+  main.type=code_typet();
+  goto_programt &program=main.body;
+
+  goto_programt::targett i=program.add_instruction(ASSIGN);
+  i->code=code_assignt(x, from_integer(0, x.type()));
+
+  goto_programt::targett head=program.add_instruction(GOTO);
+  head->guard=not_exprt(
+    binary_relation_exprt(x, ID_lt, from_integer(bound, x.type())));
+
+  i=program.add_instruction(ASSIGN);
+  i->code=code_assignt(x, plus_exprt(x, from_integer(step, x.type())));
+  i=program.add_instruction(GOTO);
+  i->targets.push_back(head);
+
+  goto_programt::targett exit=program.add_instruction(ASSIGN);
+  exit->code=code_assignt(y, x);
+  head->targets.push_back(exit);
+  program.add_instruction(END_FUNCTION);
+
+  goto_functions.update();
+  return exit;
+}
+
+SCENARIO(
+  "widening_ait terminates quickly on counting loops",
+  "[core][analyses][ai]")
+{
+  symbol_tablet symbol_table;
+  const signedbv_typet int_type(32);
+  const namespacet ns(symbol_table);
+  const symbol_exprt x("x", int_type);
+  const symbol_exprt y("y", int_type);
+
+  GIVEN("A loop counting to 10000")
+  {
+    goto_functionst goto_functions;
+    const goto_programt::const_targett exit=
+      make_loop(goto_functions, x, y, 10000, 1);
+
+    ait<interval_domaint> plain;
+    plain(goto_functions, ns);
+
+    widening_ait<interval_domaint> widening;
+    widening(goto_functions, ns);
+
+    THEN("Widening needs far fewer iterations")
+    {
+      REQUIRE(plain.get_number_of_visits()>10000);
+      REQUIRE(widening.get_number_of_visits()<20);
+    }
+
+    THEN("The thresholds keep the result precise")
+    {
+      REQUIRE(state_string(widening, exit, ns)==state_string(plain, exit, ns));
+      REQUIRE(state_string(widening, exit, ns)=="10000 <= x <= 10000\n");
+    }
+  }
+
+  GIVEN("A loop whose counter overshoots all thresholds")
+  {
+    goto_functionst goto_functions;
+    const goto_programt::const_targett exit=
+      make_loop(goto_functions, x, y, 10, 3);
+
+    WHEN("No descending iterations are done")
+    {
+      widening_ait<interval_domaint> widening(0);
+      widening(goto_functions, ns);
+
+      THEN("The upper bound is lost")
+      {
+        REQUIRE(state_string(widening, exit, ns)=="10 <= x\n");
+      }
+    }
+
+    WHEN("Descending iterations are done")
+    {
+      widening_ait<interval_domaint> widening;
+      widening(goto_functions, ns);
+
+      THEN("Narrowing recovers the upper bound")
+      {
+        REQUIRE(state_string(widening, exit, ns)=="10 <= x <= 12\n");
+      }
+    }
+  }
+}
@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+ Module: Unit tests for the bit vectors of custom_bitvector_domaint
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <analyses/custom_bitvector_analysis.h>
+
+typedef custom_bitvector_domaint::bit_vectort bit_vectort;
+
+SCENARIO(
+  "custom_bitvector_domaint bit vectors hold more than 64 bits",
+  "[core][analyses][custom_bitvector_analysis]")
+{
+  GIVEN("Bits below and above 64")
+  {
+    bit_vectort v;
+    REQUIRE(v.is_zero());
+
+    v.set(3);
+    v.set(64);
+    v.set(200);
+
+    THEN("Exactly these bits are set")
+    {
+      REQUIRE(v.get(3));
+      REQUIRE(v.get(64));
+      REQUIRE(v.get(200));
+      REQUIRE_FALSE(v.get(0));
+      REQUIRE_FALSE(v.get(67));
+      REQUIRE_FALSE(v.get(136));
+      REQUIRE_FALSE(v.get(1000));
+    }
+
+    THEN("Clearing them all yields the empty vector")
+    {
+      v.clear(200);
+      REQUIRE_FALSE(v.get(200));
+      REQUIRE(v.width()==128);
+      v.clear(64);
+      v.clear(3);
+      v.clear(500);
+      REQUIRE(v.is_zero());
+      REQUIRE(v==bit_vectort());
+    }
+  }
+
+  GIVEN("Two vectors of different widths")
+  {
+    bit_vectort a, b;
+    a.set(1);
+    a.set(70);
+    b.set(70);
+    b.set(150);
+
+    THEN("The union reports whether bits were added")
+    {
+      bit_vectort u=a;
+      REQUIRE(u.unite(b));
+      REQUIRE(u.get(1));
+      REQUIRE(u.get(70));
+      REQUIRE(u.get(150));
+      REQUIRE_FALSE(u.unite(a));
+      REQUIRE_FALSE(u.unite(b));
+    }
+
+    THEN("The intersection reports whether bits were removed")
+    {
+      bit_vectort i=b;
+      REQUIRE(i.intersect(a));
+      REQUIRE(i.get(70));
+      REQUIRE_FALSE(i.get(150));
+      REQUIRE(i.width()==128);
+      REQUIRE_FALSE(i.intersect(a));
+      REQUIRE_FALSE(i.intersect(b));
+
+      bit_vectort none;
+      none.set(5);
+      REQUIRE(i.intersect(none));
+      REQUIRE(i.is_zero());
+    }
+  }
+}
@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+ Module: Unit tests for the equality of goto programs
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <goto-programs/goto_program_equal.h>
+
+#include <util/arith_tools.h>
+
+static void make_loop(goto_programt &goto_program, int bound)
+{
+  const signedbv_typet int_type(32);
+  const symbol_exprt x("x", int_type);
+
+  goto_programt::targett head=goto_program.add_instruction(ASSIGN);
+  head->code=code_assignt(x, plus_exprt(x, from_integer(1, int_type)));
+  goto_programt::targett back=goto_program.add_instruction(GOTO);
+  back->guard=binary_relation_exprt(x, ID_lt, from_integer(bound, int_type));
+  back->targets.push_back(head);
+  goto_program.add_instruction(END_FUNCTION);
+  goto_program.update();
+}
+
+SCENARIO(
+  "goto_program_equal compares functions by content",
+  "[core][goto-programs][goto_program_equal]")
+{
+  GIVEN("Two separately built copies of the same loop")
+  {
+    goto_programt body1, body2;
+    make_loop(body1, 10);
+    make_loop(body2, 10);
+
+    THEN("They are equal even though jump targets differ in memory")
+    {
+      REQUIRE(goto_program_equal(body1, body2));
+    }
+
+    WHEN("One of them is changed")
+    {
+      body2.clear();
+      make_loop(body2, 11);
+
+      THEN("The bodies are not equal")
+      {
+        REQUIRE(!goto_program_equal(body1, body2));
+      }
+    }
+
+    WHEN("A jump target of one of them is moved")
+    {
+      goto_programt::targett back=body2.instructions.begin();
+      ++back;
+      back->targets.front()=back;
+
+      THEN("The bodies are not equal")
+      {
+        REQUIRE(!goto_program_equal(body1, body2));
+      }
+    }
+  }
+}
@@ -0,0 +1,129 @@
+/*******************************************************************\
+
+ Module: Unit tests for the interpreter bytecode
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <goto-programs/interpreter_bytecode.h>
+
+#include <map>
+
+#include <util/arith_tools.h>
+
+SCENARIO(
+  "interpreter_bytecodet evaluates scalar expressions natively",
+  "[core][goto-programs][interpreter_bytecode]")
+{
+  const signedbv_typet int_type(32);
+  const symbol_exprt x("x", int_type);
+  const symbol_exprt y("y", int_type);
+
+  std::map<irep_idt, interpreter_bytecodet::valuet> values;
+  std::vector<irep_idt> loaded;
+  const interpreter_bytecodet::loadert load=
+    [&values, &loaded](
+      const symbol_exprt &symbol,
+      interpreter_bytecodet::valuet &value)
+    {
+      loaded.push_back(symbol.get_identifier());
+      auto it=values.find(symbol.get_identifier());
+      if(it==values.end())
+        return true;
+      value=it->second;
+      return false;
+    };
+
+  std::vector<interpreter_bytecodet::valuet> registers;
+  interpreter_bytecodet::valuet result;
+  interpreter_bytecodet bytecode;
+
+  GIVEN("An arithmetic expression over two symbols")
+  {
+    const plus_exprt sum(
+      mult_exprt(x, from_integer(3, int_type)),
+      minus_exprt(y, from_integer(1, int_type)));
+    REQUIRE(!bytecode.compile(sum));
+
+    THEN("It evaluates with the loaded values")
+    {
+      values["x"]=5;
+      values["y"]=-7;
+      REQUIRE(!bytecode.execute(load, registers, result));
+      REQUIRE(result==7);
+    }
+
+    THEN("Results beyond 64 bits are left to the generic evaluator")
+    {
+      values["x"]=interpreter_bytecodet::valuet(1)<<40;
+      values["y"]=0;
+      REQUIRE(bytecode.execute(load, registers, result));
+    }
+
+    THEN("Unavailable values are reported")
+    {
+      values["x"]=1;
+      REQUIRE(bytecode.execute(load, registers, result));
+    }
+  }
+
+  GIVEN("A conjunction guarding a division")
+  {
+    const and_exprt guard(
+      notequal_exprt(y, from_integer(0, int_type)),
+      equal_exprt(div_exprt(x, y), from_integer(2, int_type)));
+    REQUIRE(!bytecode.compile(guard));
+
+    THEN("Evaluation short-circuits")
+    {
+      values["y"]=0;
+      REQUIRE(!bytecode.execute(load, registers, result));
+      REQUIRE(result==0);
+      REQUIRE(loaded==std::vector<irep_idt>({"y"}));
+    }
+
+    THEN("Both conjuncts are evaluated otherwise")
+    {
+      values["x"]=-5;
+      values["y"]=-2;
+      REQUIRE(!bytecode.execute(load, registers, result));
+      REQUIRE(result==1);
+    }
+  }
+
+  GIVEN("Typecasts to narrower types")
+  {
+    const typecast_exprt to_signed(x, signedbv_typet(8));
+    const typecast_exprt to_unsigned(x, unsignedbv_typet(8));
+    interpreter_bytecodet signed_bytecode;
+    REQUIRE(!signed_bytecode.compile(to_signed));
+    REQUIRE(!bytecode.compile(to_unsigned));
+
+    THEN("Values wrap around")
+    {
+      values["x"]=200;
+      REQUIRE(!signed_bytecode.execute(load, registers, result));
+      REQUIRE(result==-56);
+      REQUIRE(!bytecode.execute(load, registers, result));
+      REQUIRE(result==200);
+
+      values["x"]=-1;
+      REQUIRE(!bytecode.execute(load, registers, result));
+      REQUIRE(result==255);
+    }
+  }
+
+  GIVEN("An expression of unsupported type")
+  {
+    const symbol_exprt p("p", pointer_typet(int_type, 64));
+
+    THEN("It is not compiled")
+    {
+      REQUIRE(bytecode.compile(equal_exprt(p, p)));
+      REQUIRE(bytecode.empty());
+    }
+  }
+}
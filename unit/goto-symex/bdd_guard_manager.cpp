@@ -0,0 +1,130 @@
+/*******************************************************************\
+
+ Module: Unit tests for merging guards via BDDs
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <goto-symex/bdd_guard_manager.h>
+
+#include <util/std_expr.h>
+
+SCENARIO(
+  "bdd_guard_managert merges guards canonically",
+  "[core][goto-symex][bdd_guard_manager]")
+{
+  bdd_guard_managert manager;
+
+  const symbol_exprt a("a", bool_typet());
+  const symbol_exprt b("b", bool_typet());
+  const symbol_exprt c("c", bool_typet());
+
+  guardt guard_a;
+  guard_a.add(a);
+
+  guardt guard_ab=guard_a;
+  guard_ab.add(b);
+
+  guardt guard_a_not_b=guard_a;
+  guard_a_not_b.add(not_exprt(b));
+
+  GIVEN("The guards of the two sides of a branch")
+  {
+    THEN("Their disjunction is the guard before the branch")
+    {
+      REQUIRE(manager.disjunction(guard_ab, guard_a_not_b)==a);
+    }
+
+    THEN("The difference leaves the branch condition")
+    {
+      REQUIRE(manager.difference(guard_ab, guard_a_not_b)==b);
+      REQUIRE(manager.difference(guard_a_not_b, guard_ab)==not_exprt(b));
+    }
+  }
+
+  GIVEN("The guards of three nested branches")
+  {
+    guardt guard_a_not_b_c=guard_a_not_b;
+    guard_a_not_b_c.add(c);
+
+    guardt guard_a_not_b_not_c=guard_a_not_b;
+    guard_a_not_b_not_c.add(not_exprt(c));
+
+    THEN("Merging them in any order yields the guard before the branches")
+    {
+      guardt merged=manager.disjunction(guard_a_not_b_c, guard_a_not_b_not_c);
+      REQUIRE(merged==guard_a_not_b);
+      REQUIRE(manager.disjunction(merged, guard_ab)==a);
+
+      merged=manager.disjunction(guard_ab, guard_a_not_b_not_c);
+      REQUIRE(manager.disjunction(merged, guard_a_not_b_c)==a);
+    }
+  }
+
+  GIVEN("Guards that are equivalent")
+  {
+    guardt guard_ba;
+    guard_ba.add(b);
+    guard_ba.add(a);
+
+    THEN("They are merged to the same flat conjunction")
+    {
+      const guardt merged_ab=manager.disjunction(guard_ab, guard_ab);
+      const guardt merged_ba=manager.disjunction(guard_ba, guard_ba);
+      REQUIRE(merged_ab==merged_ba);
+      REQUIRE(merged_ab.id()==ID_and);
+      REQUIRE(merged_ab.operands().size()==2);
+    }
+  }
+
+  GIVEN("A guard that is not a conjunction of literals")
+  {
+    guardt guard_c;
+    guard_c.add(c);
+
+    const guardt merged=manager.disjunction(guard_ab, guard_c);
+
+    THEN("Merging it with an implied guard does not change it")
+    {
+      REQUIRE(manager.disjunction(merged, guard_c)==merged);
+      REQUIRE(manager.disjunction(guard_ab, merged)==merged);
+    }
+  }
+
+  GIVEN("A guard whose subterms are shared many times")
+  {
+    // each level refers to the one below twice; as a tree, the guard
+    // has 2^64 leaves
+    exprt shared=a;
+    for(int i=0; i<64; i++)
+    {
+      const symbol_exprt cond("c"+std::to_string(i), bool_typet());
+      shared=
+        or_exprt(and_exprt(cond, shared), and_exprt(not_exprt(cond), shared));
+    }
+
+    guardt guard_shared;
+    guard_shared=shared;
+
+    THEN("It is translated once per shared subterm")
+    {
+      REQUIRE(manager.disjunction(guard_shared, guard_a)==a);
+    }
+  }
+
+  GIVEN("Trivial guards")
+  {
+    guardt true_guard;
+    guardt false_guard;
+    false_guard.make_false();
+
+    THEN("They are absorbing or neutral")
+    {
+      REQUIRE(manager.disjunction(guard_ab, true_guard).is_true());
+      REQUIRE(manager.disjunction(false_guard, guard_ab)==guard_ab);
+    }
+  }
+}
@@ -275,3 +275,43 @@ SCENARIO("miniBDD", "[core][solver][miniBDD]")
     REQUIRE(!result.is_constant());
   }
 }
+
+SCENARIO("miniBDD computed table", "[core][solver][miniBDD]")
+{
+  mini_bdd_mgrt mgr;
+
+  mini_bddt x=mgr.Var("x");
+  mini_bddt y=mgr.Var("y");
+  mini_bddt z=mgr.Var("z");
+
+  GIVEN("A result that is kept alive")
+  {
+    mini_bddt f=x&y;
+
+    THEN("Repeating the operation yields the same node")
+    {
+      REQUIRE((x&y).node==f.node);
+      REQUIRE((y&x).node==f.node);
+    }
+  }
+
+  GIVEN("A result that has been freed")
+  {
+    unsigned freed_number=(x&y).node_number();
+    std::size_t nodes=mgr.number_of_nodes();
+
+    THEN("Recycled nodes are not mistaken for cached results")
+    {
+      // this recycles the node of x&y
+      mini_bddt g=x|z;
+      REQUIRE(g.node_number()==freed_number);
+
+      mini_bddt f=x&y;
+      REQUIRE(f.node!=g.node);
+      REQUIRE(f.var()==x.var());
+      REQUIRE(f.low().is_false());
+      REQUIRE(f.high().node==y.node);
+      REQUIRE(mgr.number_of_nodes()==nodes+2);
+    }
+  }
+}
@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+ Module: Unit tests for the object maps of value_sett
+
+ Author: Diffblue Limited. All rights reserved.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <pointer-analysis/value_set.h>
+
+SCENARIO(
+  "value_sett object maps are sorted and merged linearly",
+  "[core][pointer-analysis][value_set]")
+{
+  value_sett value_set;
+
+  GIVEN("Two object maps with overlapping objects")
+  {
+    value_sett::object_mapt m1, m2;
+
+    value_set.insert(m1, 5, value_sett::objectt(0));
+    value_set.insert(m1, 1, value_sett::objectt(4));
+    value_set.insert(m1, 3, value_sett::objectt());
+
+    value_set.insert(m2, 2, value_sett::objectt(0));
+    value_set.insert(m2, 5, value_sett::objectt(8));
+    value_set.insert(m2, 1, value_sett::objectt(4));
+
+    THEN("Entries are kept in ascending object order")
+    {
+      std::vector<object_numberingt::number_type> keys;
+      for(const auto &entry : m1.read())
+        keys.push_back(entry.first);
+      REQUIRE(keys==std::vector<object_numberingt::number_type>({1, 3, 5}));
+      REQUIRE(m1.read().find(3)!=m1.read().end());
+      REQUIRE(m1.read().find(4)==m1.read().end());
+    }
+
+    WHEN("The second map is merged into the first")
+    {
+      const bool changed=value_set.make_union(m1, m2);
+
+      THEN("All objects are present and conflicting offsets are unknown")
+      {
+        REQUIRE(changed);
+        REQUIRE(m1.read().size()==4);
+        REQUIRE(m1.read().at(1)==value_sett::objectt(4));
+        REQUIRE(m1.read().at(2)==value_sett::objectt(0));
+        REQUIRE(!m1.read().at(3).offset_is_set);
+        REQUIRE(!m1.read().at(5).offset_is_set);
+      }
+
+      THEN("Merging again does not change anything")
+      {
+        REQUIRE(!value_set.make_union(m1, m2));
+      }
+    }
+
+    WHEN("A map is merged into an empty one")
+    {
+      value_sett::object_mapt empty;
+      REQUIRE(value_set.make_union(empty, m2));
+
+      THEN("The storage is shared rather than copied")
+      {
+        REQUIRE(empty.get_d()==m2.get_d());
+        REQUIRE(!value_set.make_union(empty, m2));
+      }
+    }
+  }
+}
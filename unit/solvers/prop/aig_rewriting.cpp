@@ -0,0 +1,91 @@
+/*******************************************************************\
+
+ Module: Unit tests for the construction of and-inverter graphs
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <solvers/prop/aig_prop.h>
+#include <solvers/sat/cnf_clause_list.h>
+
+SCENARIO(
+  "aig_prop_baset shares and simplifies AND nodes",
+  "[core][solvers][prop][aig]")
+{
+  aig_plus_constraintst aig;
+  aig_prop_constraintt prop(aig);
+
+  const literalt a=prop.new_variable();
+  const literalt b=prop.new_variable();
+  const literalt c=prop.new_variable();
+
+  GIVEN("A conjunction of two variables")
+  {
+    const literalt ab=prop.land(a, b);
+    const std::size_t nodes=aig.number_of_nodes();
+
+    THEN("Structurally identical nodes are shared")
+    {
+      REQUIRE(prop.land(b, a)==ab);
+      REQUIRE(prop.lor(!a, !b)==!ab);
+      REQUIRE(aig.number_of_nodes()==nodes);
+    }
+
+    THEN("Idempotence and contradiction are detected")
+    {
+      REQUIRE(prop.land(a, ab)==ab);
+      REQUIRE(prop.land(ab, !b).is_false());
+      REQUIRE(prop.land(ab, prop.land(!a, c)).is_false());
+      REQUIRE(aig.number_of_nodes()==nodes+1);
+    }
+
+    THEN("Subsumption and substitution are applied")
+    {
+      REQUIRE(prop.land(!a, !ab)==!a);
+      REQUIRE(prop.land(a, !ab)==prop.land(a, !b));
+    }
+  }
+}
+
+SCENARIO(
+  "aig_prop_solvert evaluates gates on the model of the inputs",
+  "[core][solvers][prop][aig]")
+{
+  cnf_clause_list_assignmentt cnf;
+  aig_prop_solvert prop(cnf);
+
+  const literalt a=prop.new_variable();
+  const literalt b=prop.new_variable();
+  const literalt c=prop.new_variable();
+  const literalt d=prop.new_variable();
+
+  // ab is only used by abc, so it is inlined into the clauses of abc;
+  // ad is not used by any constraint, so it gets no clauses
+  const literalt ab=prop.land(a, b);
+  const literalt abc=prop.land(ab, c);
+  const literalt ad=prop.land(a, d);
+  prop.l_set_to_true(abc);
+
+  prop.prop_solve();
+
+  GIVEN("A model that leaves the variables of the gates false")
+  {
+    cnf_clause_list_assignmentt::assignmentt &assignment=
+      cnf.get_assignment();
+    assignment.resize(cnf.no_variables(), tvt(false));
+    assignment[a.var_no()]=tvt(true);
+    assignment[b.var_no()]=tvt(true);
+    assignment[c.var_no()]=tvt(true);
+
+    THEN("The values of the gates follow from the inputs")
+    {
+      REQUIRE(prop.l_get(abc).is_true());
+      REQUIRE(prop.l_get(ab).is_true());
+      REQUIRE(prop.l_get(!ab).is_false());
+      REQUIRE(prop.l_get(ad).is_false());
+    }
+  }
+}
@@ -0,0 +1,79 @@
+/*******************************************************************\
+
+ Module: Unit tests for structural hashing in cnft
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <solvers/sat/cnf_clause_list.h>
+
+SCENARIO(
+  "cnft reuses structurally identical gates",
+  "[core][solvers][sat][cnf]")
+{
+  cnf_clause_listt cnf;
+
+  const literalt a=cnf.new_variable();
+  const literalt b=cnf.new_variable();
+  const literalt c=cnf.new_variable();
+
+  GIVEN("Structural hashing is disabled")
+  {
+    THEN("Every gate gets a fresh output")
+    {
+      const literalt o1=cnf.land(a, b);
+      const literalt o2=cnf.land(b, a);
+      REQUIRE(o1!=o2);
+      REQUIRE(cnf.no_hashed_gates()==0);
+    }
+  }
+
+  GIVEN("Structural hashing is enabled")
+  {
+    cnf.set_structural_hashing(true);
+
+    THEN("Commuted AND and the dual OR share the output")
+    {
+      const literalt o=cnf.land(a, b);
+      const std::size_t clauses=cnf.no_clauses();
+
+      REQUIRE(cnf.land(b, a)==o);
+      REQUIRE(cnf.lnor(!a, !b)==o);
+      REQUIRE(cnf.lor(!b, !a)==!o);
+      REQUIRE(cnf.no_clauses()==clauses);
+      REQUIRE(cnf.no_hashed_gates()==3);
+      REQUIRE(cnf.no_hashed_clauses()==9);
+    }
+
+    THEN("XOR with negated inputs negates the output")
+    {
+      const literalt o=cnf.lxor(a, b);
+      REQUIRE(cnf.lxor(b, a)==o);
+      REQUIRE(cnf.lxor(!a, b)==!o);
+      REQUIRE(cnf.lequal(a, !b)==o);
+    }
+
+    THEN("If-then-else is normalised on condition and branches")
+    {
+      const literalt o=cnf.lselect(a, b, c);
+      REQUIRE(cnf.lselect(!a, c, b)==o);
+      REQUIRE(cnf.lselect(a, !b, !c)==!o);
+    }
+
+    THEN("Complementary inputs are folded to constants")
+    {
+      REQUIRE(cnf.land(a, !a).is_false());
+      REQUIRE(cnf.lor(a, !a).is_true());
+    }
+
+    THEN("Clearing the cache forgets previous gates")
+    {
+      const literalt o=cnf.land(a, b);
+      cnf.clear_gate_cache();
+      REQUIRE(cnf.land(a, b)!=o);
+    }
+  }
+}
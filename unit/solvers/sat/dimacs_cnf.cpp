@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+ Module: Unit tests for the clause storage and DIMACS output
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <sstream>
+
+#include <solvers/sat/dimacs_cnf.h>
+
+SCENARIO(
+  "dimacs_cnft stores clauses in an arena and writes DIMACS",
+  "[core][solvers][sat][dimacs]")
+{
+  dimacs_cnft cnf;
+
+  const literalt a=cnf.new_variable();
+  const literalt b=cnf.new_variable();
+  const literalt c=cnf.new_variable();
+
+  cnf.lcnf({a, !b});
+  cnf.lcnf({c});
+  cnf.lcnf({!a, b, !c, b});
+  cnf.lcnf({a, !a}); // trivially satisfied, dropped
+
+  GIVEN("The clauses in the arena")
+  {
+    const cnf_clause_listt::clausest &clauses=cnf.get_clauses();
+
+    THEN("Clauses are stored simplified and in order")
+    {
+      REQUIRE(clauses.size()==3);
+      REQUIRE(clauses.number_of_literals()==6);
+
+      std::vector<bvt> copies(clauses.begin(), clauses.end());
+      REQUIRE(copies[0]==bvt({a, !b}));
+      REQUIRE(copies[1]==bvt({c}));
+      REQUIRE(copies[2]==bvt({!a, b, !c}));
+
+      auto it=clauses.begin();
+      ++it;
+      REQUIRE(it->size()==1);
+      REQUIRE((*it)[0]==c);
+    }
+  }
+
+  GIVEN("The DIMACS output")
+  {
+    std::ostringstream out;
+    cnf.write_dimacs_cnf(out);
+
+    THEN("The problem line and all clauses are written")
+    {
+      REQUIRE(
+        out.str()==
+        "p cnf 3 3\n"
+        "1 -2 0\n"
+        "3 0\n"
+        "-1 2 -3 0\n");
+    }
+  }
+}
@@ -0,0 +1,24 @@
+/*******************************************************************\
+
+ Module: Unit test utilities
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Utility for printing the state of an interval analysis at a location
+
+#include "interval_state.h"
+
+#include <sstream>
+
+std::string state_string(
+  const ait<interval_domaint> &analysis,
+  goto_programt::const_targett t,
+  const namespacet &ns)
+{
+  std::ostringstream out;
+  analysis[t].output(out, analysis, ns);
+  return out.str();
+}
@@ -0,0 +1,25 @@
+/*******************************************************************\
+
+ Module: Unit test utilities
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Utility for printing the state of an interval analysis at a location
+
+#ifndef CPROVER_TESTING_UTILS_INTERVAL_STATE_H
+#define CPROVER_TESTING_UTILS_INTERVAL_STATE_H
+
+#include <string>
+
+#include <analyses/interval_domain.h>
+
+/// \return the output of the interval domain at \p t, e.g., "0 <= x\n"
+std::string state_string(
+  const ait<interval_domaint> &analysis,
+  goto_programt::const_targett t,
+  const namespacet &ns);
+
+#endif // CPROVER_TESTING_UTILS_INTERVAL_STATE_H